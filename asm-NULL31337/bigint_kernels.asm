@@ -0,0 +1,158 @@
+                section         .text
+
+; The long arithmetic loops of add.asm, sub.asm and mul.asm as System V AMD64 functions, to be linked into
+; C and C++ programs through bigint_kernels.h: the arguments come in rdi, rsi, rdx, rcx, the result is
+; returned in rax and only the registers the caller saves itself are changed. A long number is an array of
+; 32-bit limbs, least significant first, and its length may be zero. The loops read and write the limbs in
+; pairs as qwords, which needs no alignment, and handle an odd last limb on its own.
+
+                global          bigint_add_n
+                global          bigint_add_displacement_n
+                global          bigint_sub_n
+                global          bigint_mul_1
+                global          bigint_div_1
+
+; adds two long numbers
+;    rdi -- address of summand #1 (long number)
+;    rsi -- address of summand #2 (long number)
+;    rdx -- length of long numbers in limbs
+; result:
+;    sum is written to rdi
+;    rax -- carry out of the top limb
+bigint_add_n:
+                xor             eax, eax
+                mov             r8, rdx
+                and             r8d, 1
+                shr             rdx, 1
+                clc                             ; keeps ZF of the qword count
+                jz              .tail
+.loop:
+                mov             rcx, [rsi]
+                lea             rsi, [rsi + 8]
+                adc             [rdi], rcx
+                lea             rdi, [rdi + 8]
+                dec             rdx
+                jnz             .loop
+.tail:
+                dec             r8              ; zero for an odd length, dec keeps CF
+                jnz             .done
+                mov             ecx, [rsi]
+                adc             [rdi], ecx
+.done:
+                setc            al
+                ret
+
+; adds a long number to another with displacement, as the rows of a product are added
+;    rdi -- address of summand #1 (long number)
+;    rsi -- address of summand #2 (long number)
+;    rdx -- length of summand #2 in limbs
+;    rcx -- length displacement in limbs
+; result:
+;    sum is written to rdi starting rcx limbs up
+;    rax -- carry out of the top limb
+bigint_add_displacement_n:
+                lea             rdi, [rdi + rcx * 4]
+                jmp             bigint_add_n
+
+; subtracts a long number from another
+;    rdi -- address of minuend (long number)
+;    rsi -- address of subtrahend (long number)
+;    rdx -- length of long numbers in limbs
+; result:
+;    difference is written to rdi
+;    rax -- borrow out of the top limb
+bigint_sub_n:
+                xor             eax, eax
+                mov             r8, rdx
+                and             r8d, 1
+                shr             rdx, 1
+                clc
+                jz              .tail
+.loop:
+                mov             rcx, [rsi]
+                lea             rsi, [rsi + 8]
+                sbb             [rdi], rcx
+                lea             rdi, [rdi + 8]
+                dec             rdx
+                jnz             .loop
+.tail:
+                dec             r8
+                jnz             .done
+                mov             ecx, [rsi]
+                sbb             [rdi], ecx
+.done:
+                setc            al
+                ret
+
+; multiplies long number by a short and adds another short
+;    rdi -- address of multiplier #1 (long number)
+;    rsi -- length of long number in limbs
+;    edx -- multiplier #2 (32-bit unsigned)
+;    ecx -- addend (32-bit unsigned)
+; result:
+;    product is written to rdi
+;    rax -- limb carried out of the top, a qword times a limb plus a limb leaves less than 2^32
+bigint_mul_1:
+                mov             r8d, edx
+                mov             r9d, ecx
+                mov             r10, rsi
+                shr             rsi, 1
+                jz              .tail
+.loop:
+                mov             rax, [rdi]
+                mul             r8
+                add             rax, r9
+                adc             rdx, 0
+                mov             [rdi], rax
+                add             rdi, 8
+                mov             r9, rdx
+                dec             rsi
+                jnz             .loop
+.tail:
+                test            r10, 1
+                jz              .done
+                mov             eax, [rdi]
+                imul            rax, r8         ; a limb times a limb plus a limb fits a qword
+                add             rax, r9
+                mov             [rdi], eax
+                shr             rax, 32
+                mov             r9, rax
+.done:
+                mov             rax, r9
+                ret
+
+; divides long number by a short
+;    rdi -- address of dividend (long number)
+;    rsi -- length of long number in limbs
+;    edx -- divisor (32-bit unsigned)
+;    ecx -- remainder of the more significant limbs, less than the divisor
+; result:
+;    quotient is written to rdi
+;    rax -- remainder
+bigint_div_1:
+                mov             r8d, edx
+                mov             edx, ecx
+                test            rsi, 1
+                jz              .pairs
+
+                mov             eax, [rdi + rsi * 4 - 4]    ; an odd top limb is divided first
+                div             r8d
+                mov             [rdi + rsi * 4 - 4], eax
+.pairs:
+                shr             rsi, 1
+                jz              .done
+
+                lea             rdi, [rdi + rsi * 8 - 8]
+.loop:
+                mov             rax, [rdi]
+                div             r8
+                mov             [rdi], rax
+                sub             rdi, 8
+                dec             rsi
+                jnz             .loop
+.done:
+                mov             eax, edx
+                ret
+
+; the stack doesn't need to be executable
+                section         .note.GNU-stack noalloc noexec nowrite progbits
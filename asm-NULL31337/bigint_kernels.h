@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Long numbers are arrays of n 32-bit limbs, least significant first, n may be zero. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* dst += src, returns the carry out of the top limb */
+uint32_t bigint_add_n(uint32_t* dst, uint32_t const* src, size_t n);
+
+/* dst[displacement..displacement + n) += src, returns the carry out of the top limb */
+uint32_t bigint_add_displacement_n(uint32_t* dst, uint32_t const* src, size_t n, size_t displacement);
+
+/* dst -= src, returns the borrow out of the top limb */
+uint32_t bigint_sub_n(uint32_t* dst, uint32_t const* src, size_t n);
+
+/* dst = dst * factor + addend, returns the limb carried out of the top */
+uint32_t bigint_mul_1(uint32_t* dst, size_t n, uint32_t factor, uint32_t addend);
+
+/* dst = (remainder * 2^(32 n) + dst) / divisor with remainder < divisor, returns the new remainder */
+uint32_t bigint_div_1(uint32_t* dst, size_t n, uint32_t divisor, uint32_t remainder);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,291 @@
+#include "../big_integer.h"
+#ifdef BIGINT_BENCH_GMP
+#include "../ci-extra/big_integer_gmp.h"
+#endif
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Every case is run for big_integer and, when built with GMP, for big_integer_gmp on operands of the same size.
+// The argument is the operand size in 32-bit limbs. After the runs a table with the time ratio of the two
+// implementations is printed, so crossover points of the algorithms show up as jumps in the ratio.
+namespace
+{
+    constexpr int64_t MAX_LIMBS = 1 << 20;
+    // division and decimal conversion are quadratic, larger sizes would run for minutes
+    constexpr int64_t MAX_QUADRATIC_LIMBS = 1 << 15;
+
+    // operands are built by halves, so even a million limbs takes O(n log n) shifts and additions
+    template <typename T>
+    T random_number(size_t limbs, std::mt19937& rng)
+    {
+        if (limbs == 1)
+        {
+            uint32_t limb = rng() | (1u << 31);
+            return (T(static_cast<int>(limb >> 16)) << 16) + T(static_cast<int>(limb & 0xFFFF));
+        }
+        size_t low = limbs / 2;
+        T res = random_number<T>(limbs - low, rng) << static_cast<int>(32 * low);
+        return res + random_number<T>(low, rng);
+    }
+
+    template <typename T>
+    std::pair<T, T> operands(benchmark::State const& state, size_t first_scale = 1)
+    {
+        std::mt19937 rng(static_cast<uint32_t>(state.range(0)));
+        size_t limbs = static_cast<size_t>(state.range(0));
+        T a = random_number<T>(limbs * first_scale, rng);
+        T b = random_number<T>(limbs, rng);
+        return {a, b};
+    }
+
+    template <typename T>
+    void bench_add(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a + b);
+        }
+    }
+
+    template <typename T>
+    void bench_sub(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(b - a);
+        }
+    }
+
+    template <typename T>
+    void bench_mul(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a * b);
+        }
+    }
+
+    // 2n by n limbs, so the quotient has n limbs too
+    template <typename T>
+    void bench_div(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state, 2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a / b);
+        }
+    }
+
+    template <typename T>
+    void bench_mod(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state, 2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a % b);
+        }
+    }
+
+    // the quotient of a known multiple, as / above but without estimating quotient limbs
+    template <typename T>
+    void bench_divexact(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        T product = a * b;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(divexact(product, b));
+        }
+    }
+
+    // a one-limb divisor only known at runtime, as in a / 7 with a variable
+    template <typename T>
+    void bench_div_limb(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        int divisor = 1000003;
+        benchmark::DoNotOptimize(divisor);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a / divisor);
+        }
+    }
+
+    template <typename T>
+    void bench_mod_limb(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        int divisor = 1000003;
+        benchmark::DoNotOptimize(divisor);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a % divisor);
+        }
+    }
+
+    template <typename T>
+    void bench_shl(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a << 1001);
+        }
+    }
+
+    template <typename T>
+    void bench_shr(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a >> 1001);
+        }
+    }
+
+    template <typename T>
+    void bench_and(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        b = -b;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a & b);
+        }
+    }
+
+    template <typename T>
+    void bench_or(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        b = -b;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a | b);
+        }
+    }
+
+    template <typename T>
+    void bench_xor(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        b = -b;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a ^ b);
+        }
+    }
+
+    template <typename T>
+    void bench_to_string(benchmark::State& state)
+    {
+        auto [a, b] = operands<T>(state);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(to_string(a));
+        }
+    }
+
+    template <typename T>
+    void bench_parse(benchmark::State& state)
+    {
+        std::string str = to_string(operands<T>(state).first);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(T(str));
+        }
+    }
+
+    // keeps the console output and collects the times of both implementations for the ratio table
+    struct ratio_reporter : benchmark::ConsoleReporter
+    {
+        void ReportRuns(std::vector<Run> const& reports) override
+        {
+            ConsoleReporter::ReportRuns(reports);
+            for (Run const& run : reports)
+            {
+                if (run.error_occurred || run.run_type != Run::RT_Iteration)
+                {
+                    continue;
+                }
+                // names look like bench_mul<big_integer>/4096
+                std::string name = run.benchmark_name();
+                size_t open = name.find('<'), close = name.find('>');
+                if (open == std::string::npos || close == std::string::npos)
+                {
+                    continue;
+                }
+                std::pair<std::string, long> key(name.substr(0, open), std::stol(name.substr(close + 2)));
+                std::string type = name.substr(open + 1, close - open - 1);
+                (type == "big_integer" ? times[key].first : times[key].second) = run.GetAdjustedRealTime();
+            }
+        }
+
+        void Finalize() override
+        {
+            std::ostream& out = GetOutputStream();
+            out << "\n" << std::left << std::setw(32) << "case" << "big_integer / gmp\n";
+            for (auto const& [key, time] : times)
+            {
+                if (time.first > 0 && time.second > 0)
+                {
+                    std::string name = key.first + "/" + std::to_string(key.second);
+                    out << std::left << std::setw(32) << name << std::fixed << std::setprecision(2)
+                        << time.first / time.second << "\n";
+                }
+            }
+            ConsoleReporter::Finalize();
+        }
+
+    private:
+        std::map<std::pair<std::string, long>, std::pair<double, double>> times;
+    };
+} // namespace
+
+#define BIGINT_BENCHMARK(name, type, max_limbs)                                                                \
+    BENCHMARK_TEMPLATE(name, type)->RangeMultiplier(8)->Range(1, max_limbs)->Unit(benchmark::kMicrosecond)
+
+#ifdef BIGINT_BENCH_GMP
+#define BIGINT_BENCHMARK_ALL(name, max_limbs)                                                                  \
+    BIGINT_BENCHMARK(name, big_integer, max_limbs);                                                            \
+    BIGINT_BENCHMARK(name, big_integer_gmp, max_limbs)
+#else
+#define BIGINT_BENCHMARK_ALL(name, max_limbs) BIGINT_BENCHMARK(name, big_integer, max_limbs)
+#endif
+
+BIGINT_BENCHMARK_ALL(bench_add, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_sub, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_mul, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_div, MAX_QUADRATIC_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_mod, MAX_QUADRATIC_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_divexact, MAX_QUADRATIC_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_div_limb, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_mod_limb, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_shl, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_shr, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_and, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_or, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_xor, MAX_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_to_string, MAX_QUADRATIC_LIMBS);
+BIGINT_BENCHMARK_ALL(bench_parse, MAX_QUADRATIC_LIMBS);
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    ratio_reporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+}
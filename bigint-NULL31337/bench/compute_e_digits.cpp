@@ -0,0 +1,28 @@
+#include "../binary_splitting.h"
+#include "phase_timer.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <digits>" << std::endl;
+        return 1;
+    }
+    uint64_t digits = std::strtoull(argv[1], nullptr, 10);
+    uint64_t precision = digits + 10;
+    phase_timer timer;
+
+    binary_splitting_result res = binary_split(e_series(), 0, e_series_terms(precision));
+    timer("series");
+    big_integer scale = pow(big_integer(10), static_cast<uint32_t>(precision));
+    timer("power");
+    big_integer e = res.t * scale / res.q;
+    timer("division");
+    std::string str = to_string(e);
+    timer("to_string");
+
+    std::cout << str[0] << '.' << str.substr(1, digits) << std::endl;
+}
@@ -0,0 +1,28 @@
+#include "../binary_splitting.h"
+#include "phase_timer.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <digits>" << std::endl;
+        return 1;
+    }
+    uint64_t digits = std::strtoull(argv[1], nullptr, 10);
+    uint64_t precision = digits + 10;
+    phase_timer timer;
+
+    binary_splitting_result res = binary_split(chudnovsky_series(), 0, chudnovsky_series_terms(precision));
+    timer("series");
+    big_integer root = isqrt(10005 * pow(big_integer(10), static_cast<uint32_t>(2 * precision)));
+    timer("sqrt");
+    big_integer pi = 426880 * root * res.q / res.t;
+    timer("division");
+    std::string str = to_string(pi);
+    timer("to_string");
+
+    std::cout << str[0] << '.' << str.substr(1, digits) << std::endl;
+}
@@ -0,0 +1,157 @@
+#include "../limb_divisor.h"
+#include "bigint_kernels.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// The asm kernels of ../asm-NULL31337 against the loops in C++ that big_integer runs without them, on the
+// same limbs. The argument is the size in 32-bit limbs.
+namespace
+{
+    constexpr int64_t MAX_LIMBS = 1 << 16;
+
+    std::vector<uint32_t> random_limbs(size_t size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint32_t> res(size);
+        for (uint32_t& limb : res)
+        {
+            limb = static_cast<uint32_t>(rng());
+        }
+        return res;
+    }
+
+    void bench_add_cpp(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1), b = random_limbs(size, 2);
+        for (auto _ : state)
+        {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                carry += static_cast<uint64_t>(a[i]) + b[i];
+                a[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            benchmark::DoNotOptimize(carry);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void bench_add_asm(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1), b = random_limbs(size, 2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(bigint_add_n(a.data(), b.data(), size));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void bench_sub_cpp(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1), b = random_limbs(size, 2);
+        for (auto _ : state)
+        {
+            uint32_t borrow = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                uint64_t cur = static_cast<uint64_t>(a[i]) - b[i] - borrow;
+                a[i] = static_cast<uint32_t>(cur);
+                borrow = static_cast<uint32_t>(cur >> 63);
+            }
+            benchmark::DoNotOptimize(borrow);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void bench_sub_asm(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1), b = random_limbs(size, 2);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(bigint_sub_n(a.data(), b.data(), size));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // the factor and the divisor are a billion, the chunk size of decimal conversions
+    constexpr uint32_t SHORT = 1000000000;
+
+    void bench_mul_limb_cpp(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1);
+        for (auto _ : state)
+        {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                carry += static_cast<uint64_t>(a[i]) * SHORT;
+                a[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            benchmark::DoNotOptimize(carry);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void bench_mul_limb_asm(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> a = random_limbs(size, 1);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(bigint_mul_1(a.data(), size, SHORT, 0));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // the dividend is restored between the runs, which costs the same for both; big_integer divides by
+    // a limb with its precomputed reciprocal
+    void bench_div_limb_cpp(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> const original = random_limbs(size, 1);
+        std::vector<uint32_t> a = original;
+        limb_divisor const divisor(SHORT);
+        for (auto _ : state)
+        {
+            a = original;
+            benchmark::DoNotOptimize(divisor.divide(a.data(), size));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void bench_div_limb_asm(benchmark::State& state)
+    {
+        size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint32_t> const original = random_limbs(size, 1);
+        std::vector<uint32_t> a = original;
+        for (auto _ : state)
+        {
+            a = original;
+            benchmark::DoNotOptimize(bigint_div_1(a.data(), size, SHORT, 0));
+            benchmark::ClobberMemory();
+        }
+    }
+} // namespace
+
+#define KERNEL_BENCHMARK(name) BENCHMARK(name)->RangeMultiplier(8)->Range(8, MAX_LIMBS)
+
+KERNEL_BENCHMARK(bench_add_cpp);
+KERNEL_BENCHMARK(bench_add_asm);
+KERNEL_BENCHMARK(bench_sub_cpp);
+KERNEL_BENCHMARK(bench_sub_asm);
+KERNEL_BENCHMARK(bench_mul_limb_cpp);
+KERNEL_BENCHMARK(bench_mul_limb_asm);
+KERNEL_BENCHMARK(bench_div_limb_cpp);
+KERNEL_BENCHMARK(bench_div_limb_asm);
+
+BENCHMARK_MAIN();
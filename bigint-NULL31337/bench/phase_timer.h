@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// prints the time spent since the previous phase to stderr, so stdout holds only the digits
+struct phase_timer
+{
+    void operator()(std::string const& phase)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::cerr << phase << ": " << std::chrono::duration<double>(now - last).count() << " s" << std::endl;
+        last = now;
+    }
+
+private:
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+};
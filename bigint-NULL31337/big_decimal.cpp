@@ -0,0 +1,405 @@
+#include "big_decimal.h"
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+
+namespace
+{
+    // 10^18 is the largest power of ten in int64_t
+    constexpr uint32_t SMALL_POWERS = 19;
+    constexpr std::array<int64_t, SMALL_POWERS> small_powers = [] {
+        std::array<int64_t, SMALL_POWERS> res{1};
+        for (size_t i = 1; i < SMALL_POWERS; i++)
+        {
+            res[i] = res[i - 1] * 10;
+        }
+        return res;
+    }();
+
+    // 10^(2^k), computed once and kept for later rescalings; the cache outlives any memory scope of its first
+    // caller, so its limbs come from new and delete
+    big_integer const& binary_power_of_ten(size_t k)
+    {
+        big_integer_memory_scope scope(std::pmr::new_delete_resource());
+        static std::mutex mutex;
+        static std::deque<big_integer> powers{10};
+        std::lock_guard<std::mutex> lock(mutex);
+        while (powers.size() <= k)
+        {
+            powers.push_back(powers.back() * powers.back());
+        }
+        return powers[k];
+    }
+
+    // 10^n from the cached powers for the bits of n, so the cache has one entry per bit and not one per n;
+    // the low four bits come from the table
+    big_integer power_of_ten(uint32_t n)
+    {
+        big_integer res = small_powers[n & 15];
+        n >>= 4;
+        for (size_t k = 4; n != 0; k++, n >>= 1)
+        {
+            if (n & 1)
+            {
+                res *= binary_power_of_ten(k);
+            }
+        }
+        return res;
+    }
+
+    uint64_t magnitude(int64_t a)
+    {
+        return a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+    }
+
+    // whether the truncated quotient gets one more unit of magnitude, half is the sign of 2|remainder| - |divisor|
+    bool round_away(rounding_mode mode, bool negative, int half, bool odd)
+    {
+        switch (mode)
+        {
+        case rounding_mode::down:
+            return false;
+        case rounding_mode::up:
+            return true;
+        case rounding_mode::floor:
+            return negative;
+        case rounding_mode::ceiling:
+            return !negative;
+        case rounding_mode::half_up:
+            return half >= 0;
+        case rounding_mode::half_down:
+            return half > 0;
+        case rounding_mode::half_even:
+            return half > 0 || (half == 0 && odd);
+        }
+        return false;
+    }
+
+    // n / d rounded, false when the quotient doesn't fit into int64_t
+    bool divide_small(int64_t n, int64_t d, rounding_mode mode, int64_t& res)
+    {
+        bool negative = (n < 0) != (d < 0);
+        uint64_t un = magnitude(n), ud = magnitude(d);
+        uint64_t q = un / ud, r = un % ud;
+        // 2r against ud without overflowing
+        if (r != 0 && round_away(mode, negative, r > ud - r ? 1 : r == ud - r ? 0 : -1, q & 1))
+        {
+            q++;
+        }
+        if (q > (negative ? static_cast<uint64_t>(INT64_MAX) + 1 : static_cast<uint64_t>(INT64_MAX)))
+        {
+            return false;
+        }
+        res = static_cast<int64_t>(negative ? 0 - q : q);
+        return true;
+    }
+
+    big_integer divide_big(big_integer const& n, big_integer const& d, rounding_mode mode)
+    {
+        bool negative = (n < 0) != (d < 0);
+        big_integer q = n / d;
+        big_integer r = n - q * d;
+        if (r != 0)
+        {
+            big_integer twice = (r < 0 ? -r : r) << 1;
+            big_integer divisor = d < 0 ? -d : d;
+            int half = twice < divisor ? -1 : divisor < twice ? 1 : 0;
+            if (round_away(mode, negative, half, q % 2 != 0))
+            {
+                negative ? --q : ++q;
+            }
+        }
+        return q;
+    }
+} // namespace
+
+big_decimal::big_decimal() = default;
+
+big_decimal::big_decimal(int64_t unscaled, uint32_t scale) : small(unscaled), exponent(scale) {}
+
+big_decimal::big_decimal(big_integer const& unscaled, uint32_t scale) : exponent(scale)
+{
+    assign(unscaled);
+}
+
+big_decimal::big_decimal(std::string const& str)
+{
+    size_t begin = (!str.empty() && (str[0] == '-' || str[0] == '+'));
+    size_t point = str.find('.', begin);
+    std::string digits = str.substr(begin, point == std::string::npos ? std::string::npos : point - begin);
+    if (point != std::string::npos)
+    {
+        digits += str.substr(point + 1);
+        exponent = static_cast<uint32_t>(str.size() - point - 1);
+    }
+    if (digits.empty() || std::any_of(digits.begin(), digits.end(), [](char c) { return c < '0' || c > '9'; }))
+    {
+        throw std::invalid_argument("Expected decimal number");
+    }
+    bool negative = begin != 0 && str[0] == '-';
+    if (digits.size() < SMALL_POWERS)
+    {
+        int64_t value = 0;
+        for (char c : digits)
+        {
+            value = value * 10 + (c - '0');
+        }
+        small = negative ? -value : value;
+    }
+    else
+    {
+        assign(big_integer((negative ? "-" : "") + digits));
+    }
+}
+
+uint32_t big_decimal::scale() const
+{
+    return exponent;
+}
+
+big_integer big_decimal::unscaled_value() const
+{
+    return big ? *big : big_integer(static_cast<long long>(small));
+}
+
+bool big_decimal::scaled_small(uint32_t digits, int64_t& res) const
+{
+    if (big)
+    {
+        return false;
+    }
+    if (small == 0 || digits == 0)
+    {
+        res = small;
+        return true;
+    }
+    if (digits >= SMALL_POWERS || magnitude(small) > static_cast<uint64_t>(INT64_MAX / small_powers[digits]))
+    {
+        return false;
+    }
+    res = small * small_powers[digits];
+    return true;
+}
+
+big_integer big_decimal::scaled_big(uint32_t digits) const
+{
+    big_integer res = unscaled_value();
+    if (digits != 0)
+    {
+        res *= power_of_ten(digits);
+    }
+    return res;
+}
+
+// values that fit into 64 bits go back to the fast path
+void big_decimal::assign(big_integer const& value)
+{
+    size_t size = value.significant_size();
+    uint64_t ext = value.sign ? UINT64_MAX << 32 : 0;
+    if (size == 1)
+    {
+        small = static_cast<int64_t>(ext | value.number[0]);
+        big.reset();
+    }
+    else if (size == 2 && (value.number[1] >> 31) == static_cast<uint32_t>(value.sign))
+    {
+        small = static_cast<int64_t>((static_cast<uint64_t>(value.number[1]) << 32) | value.number[0]);
+        big.reset();
+    }
+    else
+    {
+        big = value;
+    }
+}
+
+big_decimal big_decimal::rescale(uint32_t new_scale, rounding_mode mode) const
+{
+    big_decimal res;
+    res.exponent = new_scale;
+    if (new_scale >= exponent)
+    {
+        if (!scaled_small(new_scale - exponent, res.small))
+        {
+            res.assign(scaled_big(new_scale - exponent));
+        }
+        return res;
+    }
+    uint32_t digits = exponent - new_scale;
+    if (big || digits >= SMALL_POWERS || !divide_small(small, small_powers[digits], mode, res.small))
+    {
+        res.assign(divide_big(unscaled_value(), power_of_ten(digits), mode));
+    }
+    return res;
+}
+
+big_decimal& big_decimal::operator+=(big_decimal const& rhs)
+{
+    uint32_t common = std::max(exponent, rhs.exponent);
+    int64_t a, b;
+    if (scaled_small(common - exponent, a) && rhs.scaled_small(common - rhs.exponent, b) &&
+        !(b > 0 ? a > INT64_MAX - b : a < INT64_MIN - b))
+    {
+        small = a + b;
+    }
+    else
+    {
+        big_integer sum = scaled_big(common - exponent);
+        sum += rhs.scaled_big(common - rhs.exponent);
+        assign(sum);
+    }
+    exponent = common;
+    return *this;
+}
+
+big_decimal& big_decimal::operator-=(big_decimal const& rhs)
+{
+    uint32_t common = std::max(exponent, rhs.exponent);
+    int64_t a, b;
+    if (scaled_small(common - exponent, a) && rhs.scaled_small(common - rhs.exponent, b) &&
+        !(b < 0 ? a > INT64_MAX + b : a < INT64_MIN + b))
+    {
+        small = a - b;
+    }
+    else
+    {
+        big_integer difference = scaled_big(common - exponent);
+        difference -= rhs.scaled_big(common - rhs.exponent);
+        assign(difference);
+    }
+    exponent = common;
+    return *this;
+}
+
+big_decimal& big_decimal::operator*=(big_decimal const& rhs)
+{
+    uint64_t a = magnitude(small), b = magnitude(rhs.small);
+    if (!big && !rhs.big && (a == 0 || b <= static_cast<uint64_t>(INT64_MAX) / a))
+    {
+        small *= rhs.small;
+    }
+    else
+    {
+        assign(unscaled_value() * rhs.unscaled_value());
+    }
+    exponent += rhs.exponent;
+    return *this;
+}
+
+big_decimal big_decimal::operator+() const
+{
+    return *this;
+}
+
+big_decimal big_decimal::operator-() const
+{
+    return big_decimal() -= *this;
+}
+
+big_decimal operator+(big_decimal a, big_decimal const& b)
+{
+    return a += b;
+}
+
+big_decimal operator-(big_decimal a, big_decimal const& b)
+{
+    return a -= b;
+}
+
+big_decimal operator*(big_decimal a, big_decimal const& b)
+{
+    return a *= b;
+}
+
+big_decimal divide(big_decimal const& a, big_decimal const& b, uint32_t scale, rounding_mode mode)
+{
+    if (!b.big && b.small == 0)
+    {
+        throw std::invalid_argument("division by zero");
+    }
+    // a * 10^(scale + b.scale - a.scale) / b is the unscaled quotient, the power goes to the divisor when negative
+    int64_t shift = static_cast<int64_t>(scale) + b.exponent - a.exponent;
+    uint32_t digits = static_cast<uint32_t>(shift < 0 ? -shift : shift);
+    big_decimal res;
+    res.exponent = scale;
+    int64_t n, d;
+    if (shift >= 0 ? a.scaled_small(digits, n) && b.scaled_small(0, d)
+                   : a.scaled_small(0, n) && b.scaled_small(digits, d))
+    {
+        if (divide_small(n, d, mode, res.small))
+        {
+            return res;
+        }
+    }
+    res.assign(shift >= 0 ? divide_big(a.scaled_big(digits), b.unscaled_value(), mode)
+                          : divide_big(a.unscaled_value(), b.scaled_big(digits), mode));
+    return res;
+}
+
+int big_decimal::compare(big_decimal const& a, big_decimal const& b)
+{
+    uint32_t common = std::max(a.exponent, b.exponent);
+    int64_t x, y;
+    if (a.scaled_small(common - a.exponent, x) && b.scaled_small(common - b.exponent, y))
+    {
+        return x < y ? -1 : y < x ? 1 : 0;
+    }
+    big_integer l = a.scaled_big(common - a.exponent), r = b.scaled_big(common - b.exponent);
+    return l < r ? -1 : r < l ? 1 : 0;
+}
+
+bool operator==(big_decimal const& a, big_decimal const& b)
+{
+    return big_decimal::compare(a, b) == 0;
+}
+
+bool operator!=(big_decimal const& a, big_decimal const& b)
+{
+    return !(a == b);
+}
+
+bool operator<(big_decimal const& a, big_decimal const& b)
+{
+    return big_decimal::compare(a, b) < 0;
+}
+
+bool operator>(big_decimal const& a, big_decimal const& b)
+{
+    return b < a;
+}
+
+bool operator<=(big_decimal const& a, big_decimal const& b)
+{
+    return !(a > b);
+}
+
+bool operator>=(big_decimal const& a, big_decimal const& b)
+{
+    return !(a < b);
+}
+
+std::string to_string(big_decimal const& a)
+{
+    bool negative = a.big ? *a.big < 0 : a.small < 0;
+    std::string res = a.big ? to_string(negative ? -*a.big : *a.big) : std::to_string(magnitude(a.small));
+    if (res.size() <= a.exponent)
+    {
+        res.insert(0, a.exponent + 1 - res.size(), '0');
+    }
+    if (a.exponent != 0)
+    {
+        res.insert(res.size() - a.exponent, 1, '.');
+    }
+    if (negative)
+    {
+        res.insert(0, 1, '-');
+    }
+    return res;
+}
+
+std::ostream& operator<<(std::ostream& s, big_decimal const& a)
+{
+    return s << to_string(a);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "big_integer.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+// how a result that doesn't fit into the requested scale is rounded, the names follow java.math.RoundingMode
+enum class rounding_mode
+{
+    down,      // toward zero
+    up,        // away from zero
+    floor,     // toward negative infinity
+    ceiling,   // toward positive infinity
+    half_up,   // to the nearest, ties away from zero
+    half_down, // to the nearest, ties toward zero
+    half_even  // to the nearest, ties to the even neighbour
+};
+
+// Exact decimal unscaled * 10^-scale with the scale chosen at runtime. Addition, subtraction and
+// multiplication are exact, the result gets the larger scale or the sum of the scales; division and
+// rescaling to a smaller scale round with the given mode. Unscaled values that fit into 64 bits are kept
+// in a built-in integer and computed without any big_integer, the powers of ten for rescaling are cached.
+class big_decimal
+{
+public:
+    big_decimal();
+    big_decimal(int64_t unscaled, uint32_t scale = 0);
+    big_decimal(big_integer const& unscaled, uint32_t scale = 0);
+    // "-12.345" gets scale 3, throws std::invalid_argument for anything else than digits with an optional
+    // sign and decimal point
+    explicit big_decimal(std::string const& str);
+
+    uint32_t scale() const;
+    big_integer unscaled_value() const;
+    // the same value with another scale, exact when the scale grows
+    big_decimal rescale(uint32_t new_scale, rounding_mode mode = rounding_mode::half_even) const;
+
+    big_decimal& operator+=(big_decimal const& rhs);
+    big_decimal& operator-=(big_decimal const& rhs);
+    big_decimal& operator*=(big_decimal const& rhs);
+
+    big_decimal operator+() const;
+    big_decimal operator-() const;
+
+    friend big_decimal divide(big_decimal const& a, big_decimal const& b, uint32_t scale, rounding_mode mode);
+    friend bool operator==(big_decimal const& a, big_decimal const& b);
+    friend bool operator<(big_decimal const& a, big_decimal const& b);
+    friend std::string to_string(big_decimal const& a);
+
+private:
+    static int compare(big_decimal const& a, big_decimal const& b);
+    // unscaled * 10^digits if that fits into 64 bits
+    bool scaled_small(uint32_t digits, int64_t& res) const;
+    big_integer scaled_big(uint32_t digits) const;
+    void assign(big_integer const& value);
+
+    int64_t small = 0;
+    // set when the unscaled value doesn't fit into small
+    std::optional<big_integer> big;
+    uint32_t exponent = 0;
+};
+
+big_decimal operator+(big_decimal a, big_decimal const& b);
+big_decimal operator-(big_decimal a, big_decimal const& b);
+big_decimal operator*(big_decimal a, big_decimal const& b);
+
+// a / b with the given scale of the quotient, throws std::invalid_argument for a zero b
+big_decimal divide(big_decimal const& a, big_decimal const& b, uint32_t scale,
+                   rounding_mode mode = rounding_mode::half_even);
+
+// numerical comparisons, 1.5 and 1.50 are equal
+bool operator==(big_decimal const& a, big_decimal const& b);
+bool operator!=(big_decimal const& a, big_decimal const& b);
+bool operator<(big_decimal const& a, big_decimal const& b);
+bool operator>(big_decimal const& a, big_decimal const& b);
+bool operator<=(big_decimal const& a, big_decimal const& b);
+bool operator>=(big_decimal const& a, big_decimal const& b);
+
+// all the digits of the scale, e.g. "-0.50" for unscaled -50 and scale 2
+std::string to_string(big_decimal const& a);
+std::ostream& operator<<(std::ostream& s, big_decimal const& a);
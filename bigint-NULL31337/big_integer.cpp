@@ -1,19 +1,70 @@
 #include "big_integer.h"
+#include "big_integer_stats.h"
+#include "thread_pool.h"
 #include <algorithm>
+#include <cerrno>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
-#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
 #include <vector>
 
-big_integer::big_integer() : number(1, 0), sign(false) {}
+#ifdef BIGINT_ASM_KERNELS
+#include "bigint_kernels.h"
+#endif
 
-big_integer::big_integer(big_integer const& other) = default;
+namespace
+{
+    thread_local std::pmr::memory_resource* current_resource = nullptr;
+} // namespace
+
+std::pmr::memory_resource* big_integer_memory_resource()
+{
+    return current_resource != nullptr ? current_resource : std::pmr::get_default_resource();
+}
+
+big_integer_memory_scope::big_integer_memory_scope(std::pmr::memory_resource* resource) : previous(current_resource)
+{
+    current_resource = resource;
+}
+
+big_integer_memory_scope::~big_integer_memory_scope()
+{
+    current_resource = previous;
+}
+
+big_integer::big_integer() : number(1, 0, big_integer_memory_resource()), sign(false) {}
+
+// a copy is allocated from the resource of the current scope, not from the resource of the original
+big_integer::big_integer(big_integer const& other)
+    : number(other.number, big_integer_memory_resource()), sign(other.sign)
+{
+}
+
+big_integer::big_integer(uint32_t a, bool sign_) : number(1, a, big_integer_memory_resource()), sign(sign_) {}
 
-big_integer::big_integer(uint32_t a, bool sign_) : number(1, a), sign(sign_) {}
+// nonnegative value from its magnitude limbs
+big_integer::big_integer(uint32_t const* limbs, size_t size)
+    : number(size, 0, big_integer_memory_resource()), sign(false)
+{
+    std::copy(limbs, limbs + size, number.data());
+    fit();
+}
 
-big_integer::big_integer(uint32_t a, uint32_t b, bool sign_) : number(1, a), sign(sign_)
+big_integer::big_integer(uint32_t a, uint32_t b, bool sign_)
+    : number(1, a, big_integer_memory_resource()), sign(sign_)
 {
     number.push_back(b);
     fit();
@@ -37,24 +88,6 @@ big_integer::big_integer(unsigned long a) : big_integer(static_cast<unsigned lon
 
 big_integer::~big_integer() = default;
 
-static uint32_t parse_uint32(std::string const& str)
-{
-    uint32_t res = 0;
-    for (size_t i = 0; i < str.size(); i++)
-    {
-        if ('0' <= str[i] && str[i] <= '9')
-        {
-            res *= 10;
-            res += (str[i] - '0');
-        }
-        else
-        {
-            throw std::invalid_argument("Expected number");
-        }
-    }
-    return res;
-}
-
 big_integer big_integer::abs() const
 {
     return sign ? -(*this) : *this;
@@ -73,101 +106,114 @@ void big_integer::negate_no_copy()
             number[i]++;
         }
     }
-    sign ^= true;
-    fit();
+    // a carry out of the limbs means they were all zero, it cancels the new sign extension of zero
+    // and turns the one of -2^(32n) into the limb 1
+    if (carry && sign)
+    {
+        number.push_back(1);
+    }
+    sign = !sign && !carry;
 }
 
-big_integer::big_integer(std::string const& str) : big_integer()
+big_integer& big_integer::operator=(big_integer const& other) = default;
+
+// the limbs past the stored ones are filled with the sign extension, the value stays the same
+void big_integer::extend(size_t size)
 {
-    for (size_t i = (str[0] == '-' || str[0] == '+'); i < str.size(); i += 9)
-    {
-        big_integer tmp;
-        int mod = 1;
-        if (i + 9 < str.size())
-        {
-            mod = 1000000000;
-        }
-        else
-        {
-            for (int j = i; j < str.size(); j++)
-            {
-                mod *= 10;
-            }
-        }
-        *this = mul_long_short(mod);
-        *this += parse_uint32(str.substr(i, 9));
-    }
-    if (str[0] == '-')
+    if (number.size() < size)
     {
-        if (str.size() == 1)
-        {
-            throw std::invalid_argument("-");
-        }
-        negate();
+        number.resize(size, sign ? UINT32_MAX : 0);
     }
-    if (str.size() == 0)
+}
+
+size_t big_integer::significant_size() const
+{
+    uint32_t ext = sign ? UINT32_MAX : 0;
+    size_t size = number.size();
+    while (size > 1 && number[size - 1] == ext)
     {
-        throw std::invalid_argument("");
+        size--;
     }
-    fit();
+    return size;
 }
 
-big_integer& big_integer::operator=(big_integer const& other) = default;
-
-uint32_t big_integer::add32c(uint32_t& first, uint32_t const& second, uint32_t const& carry)
+// the scan stops at the top limb of a canonical number
+bool big_integer::is_zero() const
 {
-    first += second + carry;
-    return ((first < second + carry || (second == UINT32_MAX && carry)) ? 1 : 0);
+    return !sign && significant_size() == 1 && number[0] == 0;
 }
 
-big_integer big_integer::reserve(big_integer const& other, size_t size)
+// The canonical form: the sign extension limbs on top are cut off with a single resize after one scan. The
+// constructors make their values canonical, the operators leave the extension limbs to the observers.
+void big_integer::fit()
 {
-    if (other.number.size() < size)
+    size_t size = significant_size();
+    // a negative number keeps one limb of its extension above a zero limb, a single zero limb is zero
+    if (sign && number[size - 1] == 0)
     {
-        big_integer tmp(other);
-        while (size != tmp.number.size())
+        if (size == number.size())
         {
-            tmp.number.push_back((tmp.sign) ? UINT32_MAX : 0);
+            number.push_back(UINT32_MAX);
         }
-        return tmp;
+        size++;
     }
-    return other;
+    number.resize(size);
 }
 
-void big_integer::fit()
+// *this += rhs or *this -= rhs, subtracting adds ~rhs + 1; rhs is read in place and its limbs past
+// the stored ones are its sign extension, so neither operand is copied or widened first
+void big_integer::add_long(big_integer const& rhs, bool subtract)
 {
-    if (number.size() == 1 && number[0] == 0)
+    uint32_t flip = subtract ? UINT32_MAX : 0;
+    uint32_t rhs_ext = (rhs.sign ? UINT32_MAX : 0) ^ flip;
+    int ext_sum = (sign ? -1 : 0) + (rhs_ext != 0 ? -1 : 0);
+    size_t rhs_size = rhs.number.size();
+    extend(rhs_size);
+    uint64_t carry = subtract ? 1 : 0;
+    size_t i = 0;
+#ifdef BIGINT_ASM_KERNELS
+    // subtracting directly borrows 1 exactly where adding ~rhs + 1 carries 0
+    i = rhs_size;
+    carry = subtract ? 1 - bigint_sub_n(number.data(), rhs.number.data(), i)
+                     : bigint_add_n(number.data(), rhs.number.data(), i);
+#endif
+    for (; i < rhs_size; i++)
     {
-        sign = false;
-        return;
+        carry += static_cast<uint64_t>(number[i]) + (rhs.number[i] ^ flip);
+        number[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
     }
-    while (number.size() > 1 && ((number.back() == UINT32_MAX && sign) || (!sign && number.back() == 0)))
+    // past rhs only rhs_ext + carry is added, once that is 0 or 2^32 the remaining limbs stay as they are
+    for (; i < number.size() && carry != (rhs_ext != 0 ? 1 : 0); i++)
     {
-        number.pop_back();
+        carry += static_cast<uint64_t>(number[i]) + rhs_ext;
+        number[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
     }
-    if (sign && number.back() == 0)
+    if (i == number.size())
     {
-        number.push_back(UINT32_MAX);
+        // the sign extensions and the carry out of the top limb
+        int top = ext_sum + static_cast<int>(carry);
+        if (top == -2 || top == 1)
+        {
+            number.push_back(top == 1 ? 1 : UINT32_MAX - 1);
+        }
+        sign = top < 0;
     }
 }
 
 big_integer& big_integer::operator+=(big_integer const& rhs)
 {
-    *this = reserve(*this, std::max(number.size(), rhs.number.size()) + 1);
-    big_integer right(reserve(rhs, std::max(number.size(), rhs.number.size() + 1)));
-    uint32_t carry = 0;
-    for (size_t i = 0; i < number.size(); i++)
-    {
-        carry = add32c(number[i], right.number[i], carry);
-    }
-    sign = number.back() >> 31;
-    fit();
+    BIGINT_STATS_SCOPE(add, std::max(number.size(), rhs.number.size()));
+    add_long(rhs, false);
     return *this;
 }
 
 big_integer& big_integer::operator-=(big_integer const& rhs)
 {
-    return *this += -rhs;
+    BIGINT_STATS_SCOPE(sub, std::max(number.size(), rhs.number.size()));
+    add_long(rhs, true);
+    return *this;
 }
 
 big_integer big_integer::mul_long_short(uint32_t second) const
@@ -186,373 +232,1925 @@ big_integer big_integer::mul_long_short(uint32_t second) const
     return ans;
 }
 
-void big_integer::myMultiply(big_integer const& left, big_integer const& right) {
-    *this = 0;
-    for (size_t i = right.number.size(); i > 0; i--)
+namespace
+{
+    constexpr size_t KARATSUBA_THRESHOLD = 32;
+
+    // dst[0..dst_size) += src[0..src_size), src_size <= dst_size
+    void add_limbs(uint32_t* dst, size_t dst_size, uint32_t const* src, size_t src_size)
     {
-        *this <<= 32;
-        *this += left.mul_long_short(right.number[i - 1]);
+        uint64_t carry = 0;
+        size_t i = 0;
+#ifdef BIGINT_ASM_KERNELS
+        i = src_size;
+        carry = bigint_add_n(dst, src, i);
+#endif
+        for (; i < src_size; i++)
+        {
+            carry += static_cast<uint64_t>(dst[i]) + src[i];
+            dst[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        for (; carry != 0 && i < dst_size; i++)
+        {
+            carry += dst[i];
+            dst[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
     }
-}
 
-big_integer& big_integer::operator*=(big_integer const& rhs)
-{
-    bool ans_sign = (sign ^ rhs.sign);
-    myMultiply((sign ? this->abs() : *this), (rhs.sign ? rhs.abs() : rhs));
-    if (ans_sign)
+    // dst[0..dst_size) -= src[0..src_size), the result must stay non-negative
+    void sub_limbs(uint32_t* dst, size_t dst_size, uint32_t const* src, size_t src_size)
     {
-        negate();
+        uint32_t borrow = 0;
+        size_t i = 0;
+#ifdef BIGINT_ASM_KERNELS
+        i = src_size;
+        borrow = bigint_sub_n(dst, src, i);
+#endif
+        for (; i < src_size; i++)
+        {
+            uint64_t cur = static_cast<uint64_t>(dst[i]) - src[i] - borrow;
+            dst[i] = static_cast<uint32_t>(cur);
+            borrow = static_cast<uint32_t>(cur >> 63);
+        }
+        for (; borrow != 0 && i < dst_size; i++)
+        {
+            borrow = (dst[i] == 0);
+            dst[i]--;
+        }
     }
-    fit();
-    return *this;
-}
 
-uint32_t big_integer::myAt(size_t pos) {
-    if (pos < number.size()) {
-        return number[pos];
+    // res[0..n+m) = a[0..n) * b[0..m)
+    void mul_basecase(uint32_t const* a, size_t n, uint32_t const* b, size_t m, uint32_t* res)
+    {
+        std::fill(res, res + n + m, 0);
+        for (size_t i = 0; i < m; i++)
+        {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; j++)
+            {
+                carry += res[i + j] + static_cast<uint64_t>(a[j]) * b[i];
+                res[i + j] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            res[i + n] = static_cast<uint32_t>(carry);
+        }
     }
-    return (sign ? UINT32_MAX : 0);
-}
 
+    // upper bound of the scratch used by mul_limbs for operands of n >= m limbs; unbalanced operands only need
+    // the product of one slice and the scratch of a balanced m by m product
+    size_t mul_scratch_size(size_t n, size_t m)
+    {
+        if (m < KARATSUBA_THRESHOLD)
+        {
+            return 0;
+        }
+        return 2 * m <= n ? 8 * m + 4096 : 6 * n + 4096;
+    }
 
-big_integer& big_integer::operator/=(big_integer const& rhs)
-{
-    bool ans_sign = (sign ^ rhs.sign);
-    big_integer left = abs();
-    big_integer right = rhs.abs();
-    if (left < right)
+    // res[0..n+m) = a[0..n) * b[0..m), Karatsuba above the threshold
+    void mul_limbs(uint32_t const* a, size_t n, uint32_t const* b, size_t m, uint32_t* res, uint32_t* scratch)
     {
-        *this = 0;
-        return *this;
+        if (n < m)
+        {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if (m < KARATSUBA_THRESHOLD)
+        {
+            mul_basecase(a, n, b, m, res);
+            return;
+        }
+        if (2 * m <= n)
+        {
+            // unbalanced operands are cut into m-limb slices of a
+            std::fill(res, res + n + m, 0);
+            for (size_t i = 0; i < n; i += m)
+            {
+                size_t len = std::min(m, n - i);
+                mul_limbs(a + i, len, b, m, scratch, scratch + 2 * m);
+                add_limbs(res + i, n + m - i, scratch, len + m);
+            }
+            return;
+        }
+        size_t h = (n + 1) / 2;
+        mul_limbs(a, h, b, h, res, scratch);
+        mul_limbs(a + h, n - h, b + h, m - h, res + 2 * h, scratch);
+
+        uint32_t* sa = scratch;
+        uint32_t* sb = sa + h + 1;
+        uint32_t* mid = sb + h + 1;
+        std::copy(a, a + h, sa);
+        sa[h] = 0;
+        add_limbs(sa, h + 1, a + h, n - h);
+        std::copy(b, b + h, sb);
+        sb[h] = 0;
+        add_limbs(sb, h + 1, b + h, m - h);
+        mul_limbs(sa, h + 1, sb, h + 1, mid, mid + 2 * h + 2);
+
+        sub_limbs(mid, 2 * h + 2, res, 2 * h);
+        sub_limbs(mid, 2 * h + 2, res + 2 * h, n + m - 2 * h);
+        add_limbs(res + h, n + m - h, mid, std::min(2 * h + 2, n + m - h));
     }
-    if (right.number.size() == 1)
+
+    // scratch the arena of a thread keeps while nothing uses it, 1 MB
+    constexpr size_t RETAINED_SCRATCH_LIMBS = static_cast<size_t>(1) << 18;
+
+    // stack of scratch buffers kept between multiplications, every thread has its own one
+    class scratch_arena
     {
-        *this = left;
-        div_long_short(right.number[0]);
+    public:
+        struct position
+        {
+            size_t block;
+            size_t used;
+        };
+
+        position mark() const
+        {
+            return {current, used};
+        }
+
+        void release(position pos)
+        {
+            current = pos.block;
+            used = pos.used;
+            if (current == 0 && used == 0)
+            {
+                // the blocks grow, the large ones of a single huge operation are returned instead of staying
+                // with the thread
+                size_t total = 0;
+                for (block const& b : blocks)
+                {
+                    total += b.size;
+                }
+                while (total > RETAINED_SCRATCH_LIMBS)
+                {
+                    total -= blocks.back().size;
+                    blocks.pop_back();
+                }
+            }
+        }
+
+        uint32_t* allocate(size_t size)
+        {
+            while (current < blocks.size() && blocks[current].size - used < size)
+            {
+                current++;
+                used = 0;
+            }
+            if (current == blocks.size())
+            {
+                size_t block_size = std::max(size, blocks.empty() ? 4096 : 2 * blocks.back().size);
+                // not zeroed, so pages of the bound that are never used don't become resident
+                blocks.push_back({std::unique_ptr<uint32_t[]>(new uint32_t[block_size]), block_size});
+#ifdef BIGINT_STATS
+                big_integer_stats::count_allocation(block_size * sizeof(uint32_t));
+#endif
+                used = 0;
+            }
+            uint32_t* res = blocks[current].data.get() + used;
+            used += size;
+            return res;
+        }
+
+    private:
+        struct block
+        {
+            std::unique_ptr<uint32_t[]> data;
+            size_t size;
+        };
+
+        std::vector<block> blocks;
+        size_t current = 0;
+        size_t used = 0;
+    };
+
+    thread_local scratch_arena arena;
+
+    // buffers allocated through a frame are returned to the arena when it goes out of scope
+    class scratch_frame
+    {
+    public:
+        scratch_frame() : start(arena.mark()) {}
+
+        ~scratch_frame()
+        {
+            arena.release(start);
+        }
+
+        scratch_frame(scratch_frame const&) = delete;
+        scratch_frame& operator=(scratch_frame const&) = delete;
+
+        uint32_t* allocate(size_t size)
+        {
+            return arena.allocate(size);
+        }
+
+    private:
+        scratch_arena::position start;
+    };
+
+    parallel_options options;
+    std::unique_ptr<thread_pool> pool;
+
+    void mul_limbs_serial(uint32_t const* a, size_t n, uint32_t const* b, size_t m, uint32_t* res)
+    {
+        scratch_frame frame;
+        mul_limbs(a, n, b, m, res, frame.allocate(mul_scratch_size(std::max(n, m), std::min(n, m))));
     }
-    else
+
+    // the same recursion as mul_limbs, but independent subproducts become tasks of the pool
+    void mul_limbs_parallel(uint32_t const* a, size_t n, uint32_t const* b, size_t m, uint32_t* res)
     {
-        *this = 0;
-        uint32_t f = static_cast<uint32_t>((static_cast<uint64_t>(UINT32_MAX) + 1) /
-                                          (static_cast<uint64_t>(right.number.back()) + 1));
-        left = left.mul_long_short(f);
-        right = right.mul_long_short(f);
-        right.fit();
-        size_t ls = left.number.size(), rs = right.number.size();
-        number.resize(ls - rs);
-        for (size_t i = ls - rs; i > 0; i--)
-        {
-            number[i - 1] = static_cast<uint32_t>(std::min(
-                ((static_cast<uint64_t>(left.myAt(i - 1 + rs)) << 32) +
-                 static_cast<uint64_t>(left.myAt(i - 2 + rs))) /
-                static_cast<uint64_t>(right.number.back()), static_cast<uint64_t>(UINT32_MAX)));
-            left -= right * number[i - 1] << ((i - 1) * 32);
-            // В пдф написано что это не будет выпоняться много раз на тестах иногда 1 раз но не больше 2 так что O(nm)
-            while (left < 0)
+        if (n < m)
+        {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if (m < std::max(options.mul_min_task_size, KARATSUBA_THRESHOLD))
+        {
+            mul_limbs_serial(a, n, b, m, res);
+            return;
+        }
+        scratch_frame frame;
+        std::vector<std::function<void()>> tasks;
+        if (2 * m <= n)
+        {
+            // products of even slices don't overlap in res, neither do products of odd slices in odd
+            uint32_t* odd = frame.allocate(n + m);
+            std::fill(res, res + n + m, 0);
+            std::fill(odd, odd + n + m, 0);
+            for (size_t i = 0; i < n; i += m)
             {
-                number[i - 1]--;
-                left += right << ((i - 1) * 32);
+                size_t len = std::min(m, n - i);
+                uint32_t* dst = ((i / m) % 2 == 0 ? res : odd) + i;
+                tasks.emplace_back([=] { mul_limbs_parallel(a + i, len, b, m, dst); });
             }
+            pool->run(tasks);
+            add_limbs(res, n + m, odd, n + m);
+            return;
         }
+        size_t h = (n + 1) / 2;
+        uint32_t* sa = frame.allocate(4 * (h + 1));
+        uint32_t* sb = sa + h + 1;
+        uint32_t* mid = sb + h + 1;
+        std::copy(a, a + h, sa);
+        sa[h] = 0;
+        add_limbs(sa, h + 1, a + h, n - h);
+        std::copy(b, b + h, sb);
+        sb[h] = 0;
+        add_limbs(sb, h + 1, b + h, m - h);
+
+        tasks.emplace_back([=] { mul_limbs_parallel(a, h, b, h, res); });
+        tasks.emplace_back([=] { mul_limbs_parallel(a + h, n - h, b + h, m - h, res + 2 * h); });
+        tasks.emplace_back([=] { mul_limbs_parallel(sa, h + 1, sb, h + 1, mid); });
+        pool->run(tasks);
+
+        sub_limbs(mid, 2 * h + 2, res, 2 * h);
+        sub_limbs(mid, 2 * h + 2, res + 2 * h, n + m - 2 * h);
+        add_limbs(res + h, n + m - h, mid, std::min(2 * h + 2, n + m - h));
     }
-    if (ans_sign)
+
+    // a^-1 mod 2^32 for odd a, every Newton step doubles the correct low bits, a itself has 3 of them
+    uint32_t limb_inverse(uint32_t a)
     {
-        negate_no_copy();
+        uint32_t res = a;
+        for (int i = 0; i < 4; i++)
+        {
+            res *= 2 - a * res;
+        }
+        return res;
     }
-    fit();
-    return *this;
-}
 
-big_integer& big_integer::operator%=(big_integer const& rhs)
-{
-    return *this -= (*this / rhs) * rhs;
-}
+    // Jebelean's exact division: q[0..qn) = u / v when v divides u, where v[0] is odd and qn is the quotient
+    // size. The quotient limbs come from the bottom, each one is the low limb of the rest times v[0]^-1, so
+    // there is nothing to estimate or correct. Only the limbs below qn are updated, u[0..qn) is destroyed.
+    void divexact_limbs(uint32_t* u, size_t qn, uint32_t const* v, size_t m, uint32_t* q)
+    {
+        uint32_t const inverse = limb_inverse(v[0]);
+        for (size_t i = 0; i < qn; i++)
+        {
+            uint32_t digit = u[i] * inverse;
+            q[i] = digit;
+            // u[i..qn) -= digit * v, u[i] becomes zero
+            size_t len = std::min(m, qn - i);
+            uint64_t borrow = 0;
+            for (size_t j = 0; j < len; j++)
+            {
+                uint64_t p = static_cast<uint64_t>(digit) * v[j] + borrow;
+                uint32_t cur = u[i + j];
+                u[i + j] = cur - static_cast<uint32_t>(p);
+                borrow = (p >> 32) + (cur < static_cast<uint32_t>(p));
+            }
+            for (size_t j = i + len; borrow != 0 && j < qn; j++)
+            {
+                uint32_t cur = u[j];
+                u[j] = cur - static_cast<uint32_t>(borrow);
+                borrow = cur < static_cast<uint32_t>(borrow);
+            }
+        }
+    }
 
-big_integer& big_integer::bitOp(big_integer const& rhs, std::function<uint32_t(uint32_t, uint32_t)> f)
-{
-    *this = reserve(*this, std::max(number.size(), rhs.number.size()));
-    big_integer right(reserve(rhs, std::max(number.size(), rhs.number.size())));
-    for (int i = 0; i < number.size(); i++)
+    // the shift that sets the high bit of a nonzero limb
+    int normalization_shift(uint32_t top)
     {
-        number[i] = f(number[i], right.number[i]);
+        int shift = 0;
+        while ((top << shift) < (1u << 31))
+        {
+            shift++;
+        }
+        return shift;
     }
-    fit();
-    sign = f(sign, rhs.sign);
-    return *this;
-}
 
-namespace
-{
-    uint32_t myAnd(uint32_t a, uint32_t b)
+    // dst[0..n) = src[0..n) << shift, returns the bits shifted out at the top; dst may be src
+    uint32_t shift_left_limbs(uint32_t const* src, size_t n, int shift, uint32_t* dst)
     {
-        return a & b;
+        uint32_t out = shift != 0 ? static_cast<uint32_t>(src[n - 1] >> (32 - shift)) : 0;
+        for (size_t i = n; i > 0; i--)
+        {
+            dst[i - 1] = (src[i - 1] << shift) |
+                         (shift != 0 && i > 1 ? static_cast<uint32_t>(src[i - 2] >> (32 - shift)) : 0);
+        }
+        return out;
     }
 
-    uint32_t myOr(uint32_t a, uint32_t b)
+    // dst[0..n) = src[0..n) >> shift with zeros shifted in at the top; dst may be src
+    void shift_right_limbs(uint32_t const* src, size_t n, int shift, uint32_t* dst)
     {
-        return a | b;
+        for (size_t i = 0; i < n; i++)
+        {
+            dst[i] = (src[i] >> shift) |
+                     (shift != 0 && i + 1 < n ? static_cast<uint32_t>(src[i + 1] << (32 - shift)) : 0);
+        }
     }
 
-    uint32_t myXor(uint32_t a, uint32_t b)
+    // Knuth's algorithm D in place on normalized operands, i.e. v[m - 1] has its high bit set: u[0..n] becomes
+    // the remainder in u[0..m) below the quotient in u[m..n], where n >= m >= 2
+    void div_limbs_normalized(uint32_t* u, size_t n, uint32_t const* v, size_t m)
     {
-        return a ^ b;
+        uint64_t const base = static_cast<uint64_t>(1) << 32;
+        for (size_t j = n - m + 1; j > 0; j--)
+        {
+            uint32_t* window = u + j - 1;
+            uint64_t top = (static_cast<uint64_t>(window[m]) << 32) | window[m - 1];
+            uint64_t qhat = top / v[m - 1];
+            uint64_t rhat = top % v[m - 1];
+            while (qhat >= base || qhat * v[m - 2] > ((rhat << 32) | window[m - 2]))
+            {
+                qhat--;
+                rhat += v[m - 1];
+                if (rhat >= base)
+                {
+                    break;
+                }
+            }
+            int64_t borrow = 0;
+            int64_t t = 0;
+            for (size_t i = 0; i < m; i++)
+            {
+                uint64_t p = qhat * v[i];
+                t = static_cast<int64_t>(window[i]) - borrow - static_cast<int64_t>(p & UINT32_MAX);
+                window[i] = static_cast<uint32_t>(t);
+                borrow = static_cast<int64_t>(p >> 32) - (t >> 32);
+            }
+            t = static_cast<int64_t>(window[m]) - borrow;
+            if (t < 0)
+            {
+                // the estimate was one too big, add the divisor back
+                qhat--;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < m; i++)
+                {
+                    carry += static_cast<uint64_t>(window[i]) + v[i];
+                    window[i] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+            // the rest of the window is below v, its top limb is free for the quotient limb
+            window[m] = static_cast<uint32_t>(qhat);
+        }
     }
-}
 
-big_integer& big_integer::operator&=(big_integer const& rhs)
+    // Knuth's algorithm D: q[0..n-m] = u / v and u[0..m) = u % v, where n >= m >= 2 and v[m - 1] != 0
+    void div_limbs(uint32_t* u, size_t n, uint32_t const* v, size_t m, uint32_t* q)
+    {
+        scratch_frame frame;
+        uint32_t* un = frame.allocate(n + 1);
+        uint32_t* vn = frame.allocate(m);
+        // after the shift the top limb of the divisor has its high bit set, so each estimate is off by at most 2
+        int shift = normalization_shift(v[m - 1]);
+        shift_left_limbs(v, m, shift, vn);
+        un[n] = shift_left_limbs(u, n, shift, un);
+        div_limbs_normalized(un, n, vn, m);
+        std::copy(un + m, un + n + 1, q);
+        shift_right_limbs(un, m, shift, u);
+    }
+} // namespace
+
+void set_parallel_options(parallel_options const& new_options)
 {
-    return bitOp(rhs, myAnd);
+    if (new_options.threads == 0)
+    {
+        pool.reset();
+    }
+    else if (!pool || pool->size() != new_options.threads)
+    {
+        pool.reset();
+        pool = std::make_unique<thread_pool>(new_options.threads);
+    }
+    options = new_options;
 }
 
-big_integer& big_integer::operator|=(big_integer const& rhs)
+parallel_options get_parallel_options()
 {
-    return bitOp(rhs, myOr);
+    return options;
 }
 
-big_integer& big_integer::operator^=(big_integer const& rhs)
+// left and right are nonnegative, only their significant limbs are multiplied
+void big_integer::myMultiply(big_integer const& left, big_integer const& right)
 {
-    return bitOp(rhs, myXor);
+    size_t n = left.significant_size(), m = right.significant_size();
+    limb_buffer res(n + m, 0, number.get_allocator());
+    if (pool && std::min(n, m) >= options.mul_threshold)
+    {
+        mul_limbs_parallel(left.number.data(), n, right.number.data(), m, res.data());
+    }
+    else
+    {
+        mul_limbs_serial(left.number.data(), n, right.number.data(), m, res.data());
+    }
+    number.swap(res);
+    sign = false;
 }
 
-big_integer& big_integer::operator<<=(int rhs)
+big_integer& big_integer::operator*=(big_integer const& rhs)
 {
-    uint32_t offset = rhs % 32, carry = 0;
-    if (offset != 0)
+    BIGINT_STATS_SCOPE(mul, std::max(number.size(), rhs.number.size()));
+    bool ans_sign = (sign ^ rhs.sign);
+    // only negative operands are copied for their magnitudes, a conditional between abs() and *this copies both
+    std::optional<big_integer> left_abs, right_abs;
+    myMultiply(sign ? left_abs.emplace(abs()) : *this, rhs.sign ? right_abs.emplace(rhs.abs()) : rhs);
+    if (ans_sign)
     {
-        for (size_t i = 0; i < number.size(); i++)
-        {
-            uint64_t tmp = (static_cast<uint64_t>(number[i]) << offset) + carry;
-            carry = static_cast<uint32_t>(tmp >> 32);
-            number[i] = static_cast<uint32_t>(tmp);
-        }
-        number.push_back(((sign ? UINT32_MAX : 0) << offset) + carry);
+        negate_no_copy();
     }
-    number.insert(number.begin(), rhs / 32, 0);
-    fit();
     return *this;
 }
 
-big_integer& big_integer::operator>>=(int rhs)
+big_integer& big_integer::operator/=(big_integer const& rhs)
 {
-    number.erase(number.begin(), number.begin() + std::min(static_cast<int>(number.size()), rhs / 32));
-    if (number.size() == 0)
+    BIGINT_STATS_SCOPE(div, std::max(number.size(), rhs.number.size()));
+    bool ans_sign = (sign ^ rhs.sign);
+    big_integer left = abs();
+    big_integer const right = rhs.abs();
+    if (left < right)
     {
-        number.push_back(0);
+        *this = 0;
         return *this;
     }
-    if (sign)
+    // the limbs of the magnitudes above their significant ones are zeros, left >= right has at least as many
+    size_t ls = left.significant_size(), rs = right.significant_size();
+    if (rs == 1)
     {
-        number.push_back(UINT32_MAX);
+        *this = left;
+        div_long_short(right.number[0]);
     }
-    rhs %= 32;
-    uint64_t carry = 0;
-    if (rhs != 0)
+    else
     {
-        for (size_t i = number.size(); i > 0; i--)
-        {
-            uint64_t tmp = (static_cast<uint64_t>(number[i - 1]) << (32 - rhs)) + carry;
-            carry = tmp << 32;
-            number[i - 1] = static_cast<uint32_t>(tmp >> 32);
-        }
+        number.assign(ls - rs + 1, 0);
+        sign = false;
+        div_limbs(left.number.data(), ls, right.number.data(), rs, number.data());
+    }
+    if (ans_sign)
+    {
+        negate_no_copy();
     }
-    if (sign)
-        number.pop_back();
-    fit();
     return *this;
 }
 
-big_integer big_integer::operator+() const
+big_integer& big_integer::operator%=(big_integer const& rhs)
+{
+    // a negative limb x is x - 2^32, the zero limb is -2^32 and its magnitude doesn't fit into a limb
+    if (rhs.significant_size() == 1 && !(rhs.sign && rhs.number[0] == 0))
+    {
+        mod_scalar(rhs.sign ? (static_cast<uint64_t>(1) << 32) - rhs.number[0] : rhs.number[0], rhs.sign);
+        return *this;
+    }
+    BIGINT_STATS_SCOPE(mod, std::max(number.size(), rhs.number.size()));
+    return *this -= (*this / rhs) * rhs;
+}
+
+namespace
+{
+    uint64_t unsigned_abs(int64_t a)
+    {
+        return a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+    }
+} // namespace
+
+big_integer& big_integer::operator+=(int64_t rhs)
 {
+    add_scalar(static_cast<uint64_t>(rhs), rhs < 0);
     return *this;
 }
 
-big_integer big_integer::operator-() const
+big_integer& big_integer::operator+=(uint64_t rhs)
 {
-    big_integer res(*this);
-    res.negate_no_copy();
-    return res;
+    add_scalar(rhs, false);
+    return *this;
 }
 
-big_integer big_integer::operator~() const
+big_integer& big_integer::operator-=(int64_t rhs)
 {
-    big_integer res(*this);
-    for (unsigned int& i : res.number)
-    {
-        i ^= UINT32_MAX;
-    }
-    res.sign = !sign;
-    return res;
+    // -rhs as 65-bit two's complement, so INT64_MIN does not overflow
+    add_scalar(0 - static_cast<uint64_t>(rhs), rhs > 0);
+    return *this;
 }
 
-big_integer& big_integer::operator++()
+big_integer& big_integer::operator-=(uint64_t rhs)
 {
-    return *this += 1;
+    add_scalar(0 - rhs, rhs != 0);
+    return *this;
 }
 
-big_integer big_integer::operator++(int)
+big_integer& big_integer::operator*=(int64_t rhs)
 {
-    big_integer res(*this);
-    *this += 1;
-    return res;
+    mul_scalar(unsigned_abs(rhs), rhs < 0);
+    return *this;
 }
 
-big_integer& big_integer::operator--()
+big_integer& big_integer::operator*=(uint64_t rhs)
 {
-    return *this -= 1;
+    mul_scalar(rhs, false);
+    return *this;
 }
 
-big_integer big_integer::operator--(int)
+big_integer& big_integer::operator/=(int64_t rhs)
 {
-    big_integer res(*this);
-    *this -= 1;
-    return res;
+    div_scalar(unsigned_abs(rhs), rhs < 0);
+    return *this;
 }
 
-big_integer operator+(big_integer a, big_integer const& b)
+big_integer& big_integer::operator/=(uint64_t rhs)
 {
-    return a += b;
+    div_scalar(rhs, false);
+    return *this;
 }
 
-big_integer operator-(big_integer a, big_integer const& b)
+big_integer& big_integer::operator%=(int64_t rhs)
 {
-    return a -= b;
+    mod_scalar(unsigned_abs(rhs), rhs < 0);
+    return *this;
 }
 
-big_integer operator*(big_integer a, big_integer const& b)
+big_integer& big_integer::operator%=(uint64_t rhs)
 {
-    return a *= b;
+    mod_scalar(rhs, false);
+    return *this;
 }
 
-big_integer operator/(big_integer a, big_integer const& b)
+// adds the 65-bit two's complement number with the low bits value and the sign extension of negative
+void big_integer::add_scalar(uint64_t value, bool negative)
 {
-    return a /= b;
+    BIGINT_STATS_SCOPE(add, number.size());
+    uint32_t ext = negative ? UINT32_MAX : 0;
+    uint32_t low = static_cast<uint32_t>(value), high = static_cast<uint32_t>(value >> 32);
+    size_t value_size = high == ext ? 1 : 2;
+    extend(value_size);
+    uint64_t carry = 0;
+    size_t i = 0;
+    // past the value only ext + carry is added, once that is 0 or 2^32 the remaining limbs stay as they are
+    for (; i < number.size() && (i < value_size || carry != (negative ? 1 : 0)); i++)
+    {
+        carry += static_cast<uint64_t>(number[i]) + (i == 0 ? low : i == 1 ? high : ext);
+        number[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+    }
+    if (i == number.size())
+    {
+        // the sign extensions and the carry out of the top limb
+        int top = (sign ? -1 : 0) + (negative ? -1 : 0) + static_cast<int>(carry);
+        if (top == -2 || top == 1)
+        {
+            number.push_back(top == 1 ? 1 : UINT32_MAX - 1);
+        }
+        sign = top < 0;
+    }
 }
 
-big_integer operator%(big_integer a, big_integer const& b)
+// the magnitude times a factor of two limbs, the product gets at most two more limbs
+void big_integer::mul_long_wide(uint64_t factor)
 {
-    return a %= b;
+    uint64_t low = static_cast<uint32_t>(factor), high = factor >> 32;
+    uint64_t carry = 0;
+    uint32_t prev = 0;
+    auto step = [&carry, low, high](uint32_t cur, uint32_t prev) {
+        uint64_t a = static_cast<uint64_t>(cur) * low, b = static_cast<uint64_t>(prev) * high;
+        uint64_t sum = carry + a;
+        uint64_t overflow = sum < a;
+        sum += b;
+        overflow += sum < b;
+        carry = (sum >> 32) | (overflow << 32);
+        return static_cast<uint32_t>(sum);
+    };
+    for (size_t i = 0; i < number.size(); i++)
+    {
+        uint32_t cur = number[i];
+        number[i] = step(cur, prev);
+        prev = cur;
+    }
+    number.push_back(step(0, prev));
+    number.push_back(static_cast<uint32_t>(carry));
 }
 
-big_integer operator&(big_integer a, big_integer const& b)
+void big_integer::mul_scalar(uint64_t magnitude, bool negative)
 {
-    return a &= b;
+    BIGINT_STATS_SCOPE(mul, number.size());
+    bool ans_sign = sign ^ negative;
+    if (sign)
+    {
+        negate_no_copy();
+    }
+    if (magnitude <= UINT32_MAX)
+    {
+        mul_add_long_short(static_cast<uint32_t>(magnitude), 0);
+    }
+    else
+    {
+        mul_long_wide(magnitude);
+    }
+    if (ans_sign)
+    {
+        negate_no_copy();
+    }
 }
 
-big_integer operator|(big_integer a, big_integer const& b)
+void big_integer::div_scalar(uint64_t magnitude, bool negative)
 {
-    return a |= b;
+    if (magnitude > UINT32_MAX)
+    {
+        big_integer divisor(magnitude);
+        *this /= negative ? -divisor : divisor;
+        return;
+    }
+    BIGINT_STATS_SCOPE(div, number.size());
+    bool ans_sign = sign ^ negative;
+    if (sign)
+    {
+        negate_no_copy();
+    }
+    div_long_short(static_cast<uint32_t>(magnitude));
+    if (ans_sign)
+    {
+        negate_no_copy();
+    }
 }
 
-big_integer operator^(big_integer a, big_integer const& b)
+// the remainder takes the sign of the dividend, as with the truncating division
+void big_integer::mod_scalar(uint64_t magnitude, bool negative)
 {
-    return a ^= b;
+    if (magnitude > UINT32_MAX)
+    {
+        big_integer divisor(magnitude);
+        *this %= negative ? -divisor : divisor;
+        return;
+    }
+    BIGINT_STATS_SCOPE(mod, number.size());
+    bool ans_sign = sign;
+    if (sign)
+    {
+        negate_no_copy();
+    }
+    number.assign(1, mod_long_short(static_cast<uint32_t>(magnitude)));
+    sign = false;
+    if (ans_sign)
+    {
+        negate_no_copy();
+    }
 }
 
-big_integer operator<<(big_integer a, int b)
+// the limbs of rhs past the stored ones are its sign extension, the sign is the operation on both extensions
+template <typename F>
+big_integer& big_integer::bitOp(big_integer const& rhs, F f)
 {
-    return a <<= b;
+    uint32_t rhs_ext = rhs.sign ? UINT32_MAX : 0;
+    size_t rhs_size = rhs.number.size();
+    extend(rhs_size);
+    for (size_t i = 0; i < rhs_size; i++)
+    {
+        number[i] = f(number[i], rhs.number[i]);
+    }
+    for (size_t i = rhs_size; i < number.size(); i++)
+    {
+        number[i] = f(number[i], rhs_ext);
+    }
+    sign = f(sign, rhs.sign);
+    return *this;
 }
 
-big_integer operator>>(big_integer a, int b)
+namespace
 {
-    return a >>= b;
+    uint32_t myAnd(uint32_t a, uint32_t b)
+    {
+        return a & b;
+    }
+
+    uint32_t myOr(uint32_t a, uint32_t b)
+    {
+        return a | b;
+    }
+
+    uint32_t myXor(uint32_t a, uint32_t b)
+    {
+        return a ^ b;
+    }
 }
 
-bool operator==(big_integer const& a, big_integer const& b)
+big_integer& big_integer::operator&=(big_integer const& rhs)
 {
-    return a.sign == b.sign && a.number.size() == b.number.size() &&
-           std::equal(a.number.begin(), a.number.end(), b.number.begin());
+    BIGINT_STATS_SCOPE(bit_and, std::max(number.size(), rhs.number.size()));
+    return bitOp(rhs, myAnd);
 }
 
-bool operator!=(big_integer const& a, big_integer const& b)
+big_integer& big_integer::operator|=(big_integer const& rhs)
 {
-    return !(a == b);
+    BIGINT_STATS_SCOPE(bit_or, std::max(number.size(), rhs.number.size()));
+    return bitOp(rhs, myOr);
 }
 
-bool operator<(big_integer const& a, big_integer const& b)
+big_integer& big_integer::operator^=(big_integer const& rhs)
 {
-    if (a.sign != b.sign)
+    BIGINT_STATS_SCOPE(bit_xor, std::max(number.size(), rhs.number.size()));
+    return bitOp(rhs, myXor);
+}
+
+big_integer& big_integer::operator<<=(int rhs)
+{
+    BIGINT_STATS_SCOPE(shl, number.size());
+    uint32_t offset = rhs % 32, carry = 0;
+    if (offset != 0)
     {
-        return a.sign;
+        for (size_t i = 0; i < number.size(); i++)
+        {
+            uint64_t tmp = (static_cast<uint64_t>(number[i]) << offset) + carry;
+            carry = static_cast<uint32_t>(tmp >> 32);
+            number[i] = static_cast<uint32_t>(tmp);
+        }
+        // the limb shifted out at the top only stays when it is more than the sign extension, so shifting
+        // back and forth doesn't keep growing the number
+        uint32_t ext = sign ? UINT32_MAX : 0;
+        uint32_t top = (ext << offset) + carry;
+        if (top != ext)
+        {
+            number.push_back(top);
+        }
+    }
+    number.insert(number.begin(), rhs / 32, 0);
+    return *this;
+}
+
+big_integer& big_integer::operator>>=(int rhs)
+{
+    BIGINT_STATS_SCOPE(shr, number.size());
+    number.erase(number.begin(), number.begin() + std::min(static_cast<int>(number.size()), rhs / 32));
+    if (number.size() == 0)
+    {
+        // everything is shifted out, negative numbers round down to -1
+        number.push_back(sign ? UINT32_MAX : 0);
+        return *this;
     }
-    if (a.number.size() != b.number.size())
+    if (sign)
     {
-        return a.sign ^ (a.number.size() < b.number.size());
+        number.push_back(UINT32_MAX);
     }
-    for (size_t i = a.number.size(); i > 0; i--)
+    rhs %= 32;
+    uint64_t carry = 0;
+    if (rhs != 0)
     {
-        if (a.number[i - 1] != b.number[i - 1])
+        for (size_t i = number.size(); i > 0; i--)
         {
-            return a.number[i - 1] < b.number[i - 1];
+            uint64_t tmp = (static_cast<uint64_t>(number[i - 1]) << (32 - rhs)) + carry;
+            carry = tmp << 32;
+            number[i - 1] = static_cast<uint32_t>(tmp >> 32);
         }
     }
-    return false;
+    if (sign)
+        number.pop_back();
+    return *this;
 }
 
-bool operator>(big_integer const& a, big_integer const& b)
+big_integer big_integer::operator+() const
 {
-    return b < a;
+    return *this;
 }
 
-bool operator<=(big_integer const& a, big_integer const& b)
+big_integer big_integer::operator-() const
 {
-    return !(a > b);
+    BIGINT_STATS_SCOPE(neg, number.size());
+    big_integer res(*this);
+    res.negate_no_copy();
+    return res;
 }
 
-bool operator>=(big_integer const& a, big_integer const& b)
+big_integer big_integer::operator~() const
 {
-    return !(a < b);
+    BIGINT_STATS_SCOPE(bit_not, number.size());
+    big_integer res(*this);
+    for (unsigned int& i : res.number)
+    {
+        i ^= UINT32_MAX;
+    }
+    res.sign = !sign;
+    return res;
 }
 
-uint32_t big_integer::div_long_short(uint32_t right)
+// the carry stops at the first limb below UINT32_MAX, so a long run of increments costs O(1) per step
+big_integer& big_integer::operator++()
 {
-    uint32_t carry = 0;
-    uint64_t tmp;
-    for (size_t i = number.size(); i > 0; i--)
+    BIGINT_STATS_SCOPE(add, number.size());
+    size_t i = 0;
+    while (i < number.size() && ++number[i] == 0)
+    {
+        i++;
+    }
+    if (i == number.size())
     {
-        tmp = (static_cast<uint64_t>(carry) << 32) + number[i - 1];
-        number[i - 1] = tmp / right;
-        carry = tmp % right;
+        // the carry leaves the stored limbs and goes into the infinite sign extension
+        if (sign)
+        {
+            sign = false;
+        }
+        else
+        {
+            number.push_back(1);
+        }
     }
-    return carry;
+    return *this;
 }
 
-std::string to_string(big_integer const& a)
+big_integer big_integer::operator++(int)
 {
-    std::stringstream str;
-    big_integer tmp(a);
-    if (tmp.sign)
-    {
-        str << "-";
-        tmp.negate();
-    }
-    if (tmp.number.size() == 1 && tmp.number[0] == 0)
+    big_integer res(*this);
+    ++*this;
+    return res;
+}
+
+big_integer& big_integer::operator--()
+{
+    BIGINT_STATS_SCOPE(sub, number.size());
+    size_t i = 0;
+    while (i < number.size() && number[i]-- == 0)
     {
-        str << "0";
+        i++;
     }
-    else
+    if (i == number.size())
     {
-        std::vector<uint32_t> ans;
-        while (tmp.number.size() > 1 || tmp.number[0] != 0)
+        if (sign)
         {
-            ans.push_back(tmp.div_long_short(static_cast<uint32_t>(1000000000)));
-            tmp.fit();
+            number.push_back(UINT32_MAX - 1);
         }
-        str << ans.back();
-        for (size_t i = ans.size() - 1; i > 0; i--)
+        else
         {
-            std::string num = std::to_string(ans[i - 1]);
-            for (size_t j = 0; j < 9 - num.size(); j++)
-            {
-                str << "0";
-            }
-            str << num;
+            sign = true;
         }
     }
-    return str.str();
+    return *this;
 }
 
-std::ostream& operator<<(std::ostream& s, big_integer const& a)
+big_integer big_integer::operator--(int)
+{
+    big_integer res(*this);
+    --*this;
+    return res;
+}
+
+namespace
+{
+    // GCC and Clang lower the builtins to POPCNT / LZCNT / TZCNT when the target has them
+    int limb_popcount(uint32_t a)
+    {
+#if defined(__GNUC__)
+        return __builtin_popcount(a);
+#else
+        int res = 0;
+        for (; a != 0; a &= a - 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    // a != 0
+    int limb_bit_length(uint32_t a)
+    {
+#if defined(__GNUC__)
+        return 32 - __builtin_clz(a);
+#else
+        int res = 0;
+        for (; a != 0; a >>= 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+
+    // a != 0
+    int limb_trailing_zeros(uint32_t a)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz(a);
+#else
+        int res = 0;
+        for (; (a & 1) == 0; a >>= 1)
+        {
+            res++;
+        }
+        return res;
+#endif
+    }
+} // namespace
+
+size_t big_integer::bit_length() const
+{
+    uint32_t ext = sign ? UINT32_MAX : 0;
+    size_t i = number.size();
+    while (i > 0 && number[i - 1] == ext)
+    {
+        i--;
+    }
+    return i == 0 ? 0 : 32 * (i - 1) + limb_bit_length(number[i - 1] ^ ext);
+}
+
+size_t big_integer::popcount() const
+{
+    uint32_t ext = sign ? UINT32_MAX : 0;
+    size_t res = 0;
+    for (uint32_t limb : number)
+    {
+        res += limb_popcount(limb ^ ext);
+    }
+    return res;
+}
+
+// the low bits of a negative number are the same as the ones of its magnitude up to the lowest set bit
+size_t big_integer::count_trailing_zeros() const
+{
+    for (size_t i = 0; i < number.size(); i++)
+    {
+        if (number[i] != 0)
+        {
+            return 32 * i + limb_trailing_zeros(number[i]);
+        }
+    }
+    // zero limbs with a set sign are -2^(32n), the lowest one bit is the first of the extension
+    return sign ? 32 * number.size() : SIZE_MAX;
+}
+
+bool big_integer::test_bit(size_t pos) const
+{
+    size_t i = pos / 32;
+    return i < number.size() ? (number[i] >> (pos % 32)) & 1 : sign;
+}
+
+big_integer& big_integer::set_bit(size_t pos)
+{
+    if (!test_bit(pos))
+    {
+        extend(pos / 32 + 1);
+        number[pos / 32] |= 1u << (pos % 32);
+    }
+    return *this;
+}
+
+big_integer& big_integer::clear_bit(size_t pos)
+{
+    if (test_bit(pos))
+    {
+        extend(pos / 32 + 1);
+        number[pos / 32] &= ~(1u << (pos % 32));
+    }
+    return *this;
+}
+
+big_integer big_integer::extract_bits(size_t lo, size_t len) const
+{
+    uint32_t ext = sign ? UINT32_MAX : 0;
+    auto limb = [this, ext](size_t i) { return i < number.size() ? number[i] : ext; };
+    size_t size = (len + 31) / 32, first = lo / 32;
+    int offset = static_cast<int>(lo % 32);
+    big_integer res;
+    res.number.assign(std::max<size_t>(size, 1), 0);
+    for (size_t i = 0; i < size; i++)
+    {
+        res.number[i] = offset == 0 ? limb(first + i)
+                                    : (limb(first + i) >> offset) | (limb(first + i + 1) << (32 - offset));
+    }
+    if (len % 32 != 0)
+    {
+        res.number[size - 1] &= (1u << (len % 32)) - 1;
+    }
+    res.fit();
+    return res;
+}
+
+big_integer operator+(big_integer a, big_integer const& b)
+{
+    return a += b;
+}
+
+big_integer operator-(big_integer a, big_integer const& b)
+{
+    return a -= b;
+}
+
+big_integer operator*(big_integer a, big_integer const& b)
+{
+    return a *= b;
+}
+
+big_integer operator/(big_integer a, big_integer const& b)
+{
+    return a /= b;
+}
+
+big_integer operator%(big_integer a, big_integer const& b)
+{
+    return a %= b;
+}
+
+big_integer operator&(big_integer a, big_integer const& b)
+{
+    return a &= b;
+}
+
+big_integer operator|(big_integer a, big_integer const& b)
+{
+    return a |= b;
+}
+
+big_integer operator^(big_integer a, big_integer const& b)
+{
+    return a ^= b;
+}
+
+big_integer operator<<(big_integer a, int b)
+{
+    return a <<= b;
+}
+
+big_integer operator>>(big_integer a, int b)
+{
+    return a >>= b;
+}
+
+// the sign is the infinite extension, so equal values have the same sign and the same significant limbs
+bool operator==(big_integer const& a, big_integer const& b)
+{
+    BIGINT_STATS_SCOPE(compare, std::max(a.number.size(), b.number.size()));
+    if (a.sign != b.sign)
+    {
+        return false;
+    }
+    size_t size = a.significant_size();
+    return size == b.significant_size() && std::equal(a.number.begin(), a.number.begin() + size, b.number.begin());
+}
+
+bool operator!=(big_integer const& a, big_integer const& b)
+{
+    return !(a == b);
+}
+
+bool operator<(big_integer const& a, big_integer const& b)
+{
+    BIGINT_STATS_SCOPE(compare, std::max(a.number.size(), b.number.size()));
+    if (a.sign != b.sign)
+    {
+        return a.sign;
+    }
+    // with the same sign, a longer significant part is further away from the extension
+    size_t size = a.significant_size(), b_size = b.significant_size();
+    if (size != b_size)
+    {
+        return a.sign ^ (size < b_size);
+    }
+    for (size_t i = size; i > 0; i--)
+    {
+        if (a.number[i - 1] != b.number[i - 1])
+        {
+            return a.number[i - 1] < b.number[i - 1];
+        }
+    }
+    return false;
+}
+
+bool operator>(big_integer const& a, big_integer const& b)
+{
+    return b < a;
+}
+
+bool operator<=(big_integer const& a, big_integer const& b)
+{
+    return !(a > b);
+}
+
+bool operator>=(big_integer const& a, big_integer const& b)
+{
+    return !(a < b);
+}
+
+// the reciprocal costs about as much as one hardware division, so a single limb is divided directly
+uint32_t big_integer::div_long_short(uint32_t right)
+{
+    if (number.size() == 1)
+    {
+        uint32_t remainder = number[0] % right;
+        number[0] /= right;
+        return remainder;
+    }
+#ifdef BIGINT_ASM_KERNELS
+    // the kernel divides two limbs at a time with the hardware division, which measured about twice as fast as
+    // one limb at a time with the reciprocal of limb_divisor; remainders alone still use the reciprocal
+    return bigint_div_1(number.data(), number.size(), right, 0);
+#else
+    return div_long_short(limb_divisor(right));
+#endif
+}
+
+uint32_t big_integer::div_long_short(limb_divisor const& right)
+{
+    return right.divide(number.data(), number.size());
+}
+
+uint32_t big_integer::mod_long_short(uint32_t right) const
+{
+    return number.size() == 1 ? number[0] % right : mod_long_short(limb_divisor(right));
+}
+
+uint32_t big_integer::mod_long_short(limb_divisor const& right) const
+{
+    return right.remainder(number.data(), number.size());
+}
+
+namespace
+{
+    uint32_t parse_uint32(char const* first, char const* last)
+    {
+        uint32_t res = 0;
+        for (; first != last; first++)
+        {
+            res = res * 10 + (*first - '0');
+        }
+        return res;
+    }
+
+    // 10^(9 * 2^level), computed once and kept for later conversions; the cache outlives any memory scope of
+    // its first caller, so its limbs come from new and delete
+    big_integer const& decimal_power(size_t level)
+    {
+        big_integer_memory_scope scope(std::pmr::new_delete_resource());
+        static std::mutex mutex;
+        static std::deque<big_integer> powers{1000000000};
+        std::lock_guard<std::mutex> lock(mutex);
+        while (powers.size() <= level)
+        {
+            powers.push_back(powers.back() * powers.back());
+        }
+        return powers[level];
+    }
+} // namespace
+
+void big_integer::mul_add_long_short(uint32_t factor, uint32_t addend)
+{
+    uint64_t carry = addend;
+    size_t i = 0;
+#ifdef BIGINT_ASM_KERNELS
+    i = number.size();
+    carry = bigint_mul_1(number.data(), i, factor, addend);
+#endif
+    for (; i < number.size(); i++)
+    {
+        carry += static_cast<uint64_t>(number[i]) * factor;
+        number[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+    }
+    if (carry != 0)
+    {
+        number.push_back(static_cast<uint32_t>(carry));
+    }
+}
+
+void big_integer::assign_decimal(char const* first, char const* last)
+{
+    number.assign(1, 0);
+    sign = false;
+    size_t chunk = (last - first + 8) % 9 + 1;
+    for (; first != last; first += chunk, chunk = 9)
+    {
+        uint32_t mod = 1;
+        for (size_t i = 0; i < chunk; i++)
+        {
+            mod *= 10;
+        }
+        mul_add_long_short(mod, parse_uint32(first, first + chunk));
+    }
+}
+
+namespace
+{
+    // the divisor is a compile-time constant here, so the compiler already replaces the hardware division by
+    // a multiplication with its reciprocal, that measured faster than limb_divisor and its normalization
+    uint32_t div_billion(uint32_t* limbs, size_t size)
+    {
+        uint64_t carry = 0;
+        for (size_t i = size; i > 0; i--)
+        {
+            uint64_t tmp = (carry << 32) | limbs[i - 1];
+            limbs[i - 1] = static_cast<uint32_t>(tmp / 1000000000);
+            carry = tmp % 1000000000;
+        }
+        return static_cast<uint32_t>(carry);
+    }
+} // namespace
+
+void big_integer::to_decimal(char* first, char* last)
+{
+    while (last != first && (number.size() > 1 || number[0] != 0))
+    {
+        uint32_t chunk = div_billion(number.data(), number.size());
+        while (number.size() > 1 && number.back() == 0)
+        {
+            number.pop_back();
+        }
+        for (int i = 0; i < 9 && last != first; i++, chunk /= 10)
+        {
+            *--last = static_cast<char>('0' + chunk % 10);
+        }
+    }
+    std::fill(first, last, '0');
+}
+
+big_integer::big_integer(std::string const& str) : big_integer()
+{
+    BIGINT_STATS_SCOPE(parse, str.size() / 9 + 1);
+    size_t begin = (!str.empty() && (str[0] == '-' || str[0] == '+'));
+    char const* first = str.data() + begin;
+    char const* last = str.data() + str.size();
+    if (first == last || std::any_of(first, last, [](char c) { return c < '0' || c > '9'; }))
+    {
+        throw std::invalid_argument("Expected number");
+    }
+    size_t task_digits = 9 * std::max<size_t>(options.conversion_threshold, 1);
+    if (pool && static_cast<size_t>(last - first) > task_digits)
+    {
+        // the lower part of every split has 9 * 2^level digits, so it is scaled by a cached power
+        std::vector<big_integer const*> powers;
+        while ((static_cast<size_t>(9) << powers.size()) < static_cast<size_t>(last - first))
+        {
+            powers.push_back(&decimal_power(powers.size()));
+        }
+        std::function<big_integer(char const*, char const*)> parse = [&](char const* l, char const* r) {
+            big_integer res;
+            size_t len = r - l;
+            if (len <= task_digits)
+            {
+                res.assign_decimal(l, r);
+                return res;
+            }
+            size_t level = 0;
+            while ((static_cast<size_t>(9) << (level + 1)) < len)
+            {
+                level++;
+            }
+            size_t low_digits = static_cast<size_t>(9) << level;
+            big_integer high, low;
+            pool->run({[&] { high = parse(l, r - low_digits); }, [&] { low = parse(r - low_digits, r); }});
+            res = high * *powers[level];
+            res += low;
+            return res;
+        };
+        *this = parse(first, last);
+    }
+    else
+    {
+        assign_decimal(first, last);
+    }
+    if (str[0] == '-')
+    {
+        negate_no_copy();
+    }
+    fit();
+}
+
+std::string to_string(big_integer const& a)
+{
+    BIGINT_STATS_SCOPE(to_string, a.number.size());
+    big_integer tmp = a.abs();
+    std::string res;
+    if (pool && tmp.number.size() >= std::max<size_t>(options.conversion_threshold, 1))
+    {
+        // tmp < 10^(9 * 2^top), every level splits the digits into two halves written by separate tasks
+        std::vector<big_integer const*> powers{&decimal_power(0)};
+        while (*powers.back() <= tmp)
+        {
+            powers.push_back(&decimal_power(powers.size()));
+        }
+        std::function<void(big_integer&, size_t, char*)> write = [&](big_integer& x, size_t level, char* out) {
+            size_t digits = static_cast<size_t>(9) << level;
+            if (level == 0 || x.number.size() < options.conversion_threshold)
+            {
+                x.to_decimal(out, out + digits);
+                return;
+            }
+            big_integer high = x / *powers[level - 1];
+            big_integer low = x - high * *powers[level - 1];
+            pool->run({[&] { write(high, level - 1, out); }, [&] { write(low, level - 1, out + digits / 2); }});
+        };
+        res.assign(1 + (static_cast<size_t>(9) << (powers.size() - 1)), '0');
+        write(tmp, powers.size() - 1, &res[1]);
+    }
+    else
+    {
+        // a limb holds less than 10 decimal digits
+        res.assign(1 + 10 * tmp.number.size(), '0');
+        tmp.to_decimal(&res[1], &res[0] + res.size());
+    }
+    size_t first = res.find_first_not_of('0', 1);
+    if (first == std::string::npos)
+    {
+        return "0";
+    }
+    if (a.sign)
+    {
+        res[--first] = '-';
+    }
+    res.erase(0, first);
+    return res;
+}
+
+big_integer pow(big_integer base, uint32_t exp)
+{
+    big_integer res = 1;
+    while (exp != 0)
+    {
+        if (exp & 1)
+        {
+            res *= base;
+        }
+        exp >>= 1;
+        if (exp != 0)
+        {
+            base *= base;
+        }
+    }
+    return res;
+}
+
+big_integer divexact(big_integer const& a, big_integer const& b)
+{
+    if (b.is_zero())
+    {
+        throw std::invalid_argument("division by zero");
+    }
+    BIGINT_STATS_SCOPE(div, std::max(a.number.size(), b.number.size()));
+    // the common power of two is shifted out, so the low limb of the divisor gets odd and invertible
+    int shift = static_cast<int>(b.count_trailing_zeros());
+    big_integer u = a.abs();
+    u >>= shift;
+    // an odd positive divisor is used as it is
+    big_integer shifted;
+    if (b.sign || shift != 0)
+    {
+        shifted = b.abs() >> shift;
+    }
+    big_integer const& v = b.sign || shift != 0 ? shifted : b;
+    size_t n = u.significant_size(), m = v.significant_size();
+    if (n < m || (n == 1 && u.number[0] == 0))
+    {
+        return 0;
+    }
+    big_integer res;
+    res.number.assign(n - m + 1, 0);
+    divexact_limbs(u.number.data(), n - m + 1, v.number.data(), m, res.number.data());
+    if (a.sign != b.sign)
+    {
+        res.negate_no_copy();
+    }
+    return res;
+}
+
+big_integer gcd(big_integer a, big_integer b)
+{
+    if (a.sign)
+    {
+        a.negate_no_copy();
+    }
+    if (b.sign)
+    {
+        b.negate_no_copy();
+    }
+    // Euclid on the limbs until both values fit into 64 bits, then on built-in integers; the loop reads the
+    // limb counts, so the remainders are made canonical
+    a.fit();
+    b.fit();
+    while (b.number.size() > 2)
+    {
+        a %= b;
+        a.fit();
+        a.number.swap(b.number);
+    }
+    if (a.number.size() > 2)
+    {
+        if (b.is_zero())
+        {
+            return a;
+        }
+        a %= b;
+        a.fit();
+    }
+    auto value = [](big_integer const& x) {
+        return (x.number.size() == 2 ? static_cast<uint64_t>(x.number[1]) << 32 : 0) + x.number[0];
+    };
+    uint64_t x = value(a), y = value(b);
+    while (y != 0)
+    {
+        x %= y;
+        std::swap(x, y);
+    }
+    return static_cast<unsigned long long>(x);
+}
+
+big_integer isqrt(big_integer const& n)
+{
+    if (n.sign)
+    {
+        throw std::invalid_argument("square root of negative number");
+    }
+    size_t size = n.significant_size();
+    if (size <= 2)
+    {
+        uint64_t value = (size == 2 ? static_cast<uint64_t>(n.number[1]) << 32 : 0) + n.number[0];
+        uint64_t res = static_cast<uint64_t>(std::sqrt(static_cast<long double>(value)));
+        while (res > 0 && value / res < res)
+        {
+            res--;
+        }
+        while (value / (res + 1) >= res + 1)
+        {
+            res++;
+        }
+        return static_cast<unsigned long long>(res);
+    }
+    // the root of the upper half of the bits is a guess with a quarter of the bits correct, one Newton step
+    // doubles that and lands a few units above the root, the products below check it without another division
+    int shift = static_cast<int>((size - 1) * 8);
+    big_integer x = isqrt(n >> (2 * shift)) << shift;
+    x = (x + n / x) >> 1;
+    while (x * x > n)
+    {
+        x = (x + n / x) >> 1;
+    }
+    return x;
+}
+
+namespace
+{
+    // numbers up to this many limbs go through to_string, larger ones are written in blocks of about this size
+    constexpr size_t STREAM_BLOCK_LIMBS = 1024;
+    // digits read from a stream are parsed in blocks of 9 * 2^STREAM_BLOCK_LEVEL
+    constexpr size_t STREAM_BLOCK_LEVEL = 10;
+    // a piece read from a stream is folded into the result once it has this fraction of the digits read before
+    constexpr size_t FOLD_RATIO = 8;
+
+    // 10^(9 * 2^level) for one stream operation. Levels up to STREAM_BLOCK_LEVEL come from the shared cache,
+    // the larger ones are squared here and freed with the object, so the powers of a huge number don't stay
+    // around after its conversion.
+    class stream_powers
+    {
+    public:
+        big_integer const& operator[](size_t level)
+        {
+            if (level <= STREAM_BLOCK_LEVEL)
+            {
+                return decimal_power(level);
+            }
+            while (large.size() < level - STREAM_BLOCK_LEVEL)
+            {
+                big_integer const& last = large.empty() ? decimal_power(STREAM_BLOCK_LEVEL) : large.back();
+                large.push_back(last * last);
+            }
+            return large[level - STREAM_BLOCK_LEVEL - 1];
+        }
+
+    private:
+        // level STREAM_BLOCK_LEVEL + 1 + i at i, a deque keeps the references handed out valid
+        std::deque<big_integer> large;
+    };
+} // namespace
+
+// The digits are written from the top while the number is split by powers of 10^9, so only the pieces still
+// to be written and one block of characters are kept instead of the whole decimal string. Every split divides
+// in place, the limbs of a piece become its upper part and only the lower part gets new ones.
+std::ostream& operator<<(std::ostream& s, big_integer const& a)
+{
+    // a field width needs the length before the first character
+    if (s.width() != 0 || a.number.size() <= STREAM_BLOCK_LIMBS)
+    {
+        return s << to_string(a);
+    }
+    BIGINT_STATS_SCOPE(to_string, a.number.size());
+    // the magnitude, with room for one more limb that the normalization of the divisions may need
+    big_integer x;
+    x.number.assign(a.number.size() + 1, a.sign ? UINT32_MAX : 0);
+    std::copy(a.number.begin(), a.number.end(), x.number.begin());
+    x.sign = a.sign;
+    if (x.sign)
+    {
+        x.negate_no_copy();
+    }
+    x.fit();
+
+    // x = high * p + low for p of at least two limbs and x >= p, x keeps high and the room for one more limb
+    auto split = [](big_integer& x, big_integer const& p) {
+        size_t n = x.number.size(), m = p.number.size();
+        while (p.number[m - 1] == 0)
+        {
+            m--;
+        }
+        scratch_frame frame;
+        uint32_t* v = frame.allocate(m);
+        int shift = normalization_shift(p.number[m - 1]);
+        shift_left_limbs(p.number.data(), m, shift, v);
+        x.number.resize(n + 1);
+        uint32_t* u = x.number.data();
+        u[n] = shift_left_limbs(u, n, shift, u);
+        div_limbs_normalized(u, n, v, m);
+        big_integer low;
+        low.number.assign(m + 1, 0);
+        shift_right_limbs(u, m, shift, low.number.data());
+        low.fit();
+        std::copy(u + m, u + n + 1, u);
+        x.number.resize(n - m + 1);
+        x.fit();
+        return low;
+    };
+    auto release = [](big_integer& x) {
+        big_integer released;
+        released.number.swap(x.number);
+    };
+
+    stream_powers powers;
+    // The top of x is cut into digits of base 10^(9 * 2^top), the largest such power with at most an eighth of
+    // the bits of x, so no power near the size of x is ever squared. 9 digits take less than 30 bits.
+    size_t top = 0;
+    while ((static_cast<size_t>(30) << (top + 4)) <= x.bit_length())
+    {
+        top++;
+    }
+    big_integer const& base = powers[top];
+    std::vector<big_integer> digits;
+    while (x >= base)
+    {
+        digits.push_back(split(x, base));
+    }
+
+    std::string buffer;
+    // x < 10^(9 * 2^level) is written with all of these digits when padded, without leading zeros otherwise
+    std::function<void(big_integer&, size_t, bool)> write = [&](big_integer& x, size_t level, bool pad) {
+        // the upper half may be far below its bound, its leading zeros are skipped by taking a lower level
+        while (!pad && level > 0 && x < powers[level - 1])
+        {
+            level--;
+        }
+        if (x.number.size() <= STREAM_BLOCK_LIMBS)
+        {
+            buffer.assign(10 * x.number.size(), '0');
+            x.to_decimal(&buffer[0], &buffer[0] + buffer.size());
+            size_t first = std::min(buffer.find_first_not_of('0'), buffer.size());
+            size_t digits = buffer.size() - first;
+            if (pad)
+            {
+                std::fill_n(std::ostreambuf_iterator<char>(s), (static_cast<size_t>(9) << level) - digits, '0');
+            }
+            s.write(buffer.data() + first, static_cast<std::streamsize>(digits));
+            return;
+        }
+        big_integer low = split(x, powers[level - 1]);
+        write(x, level - 1, pad);
+        release(x);
+        write(low, level - 1, true);
+    };
+    if (a.sign)
+    {
+        s.put('-');
+    }
+    write(x, top, false);
+    release(x);
+    for (; !digits.empty(); digits.pop_back())
+    {
+        write(digits.back(), top, true);
+    }
+    return s;
+}
+
+// Blocks of digits are parsed as they arrive and merged like a binary counter, two neighbours of 9 * 2^level
+// digits each into one of twice as many, while no more than one block of characters is held. The merges work
+// in place on the upper neighbour. A merged piece with an eighth of the digits read before it is folded
+// into the result by one multiplication, so the pending pieces and their powers stay a small part of the
+// result and the products stay unbalanced enough to need little scratch; the result still grows by a fixed
+// fraction with every fold, which keeps the work subquadratic.
+std::istream& operator>>(std::istream& s, big_integer& a)
+{
+    std::istream::sentry sentry(s);
+    if (!sentry)
+    {
+        return s;
+    }
+    std::streambuf* buf = s.rdbuf();
+    // the length isn't known in advance, the characters the stream has at hand stand in for it
+    BIGINT_STATS_SCOPE(parse, static_cast<size_t>(std::max<std::streamsize>(buf->in_avail(), 0)) / 9 + 1);
+    int c = buf->sgetc();
+    bool negative = c == '-';
+    if (c == '-' || c == '+')
+    {
+        c = buf->snextc();
+    }
+    size_t const block_digits = static_cast<size_t>(9) << STREAM_BLOCK_LEVEL;
+    stream_powers powers;
+    std::string block;
+    // in order from the top with their levels decreasing, a deque keeps the pieces in place
+    std::deque<std::pair<big_integer, size_t>> pieces;
+    big_integer piece;
+    big_integer res;
+    size_t res_digits = 0;
+    auto fold = [&] {
+        big_integer& top = pieces.front().first;
+        if (res_digits == 0)
+        {
+            res.number.swap(top.number);
+        }
+        else
+        {
+            res *= powers[pieces.front().second];
+            res += top;
+        }
+        res_digits += static_cast<size_t>(9) << pieces.front().second;
+        pieces.pop_front();
+    };
+    for (;;)
+    {
+        block.clear();
+        while (block.size() < block_digits && c >= '0' && c <= '9')
+        {
+            block.push_back(static_cast<char>(c));
+            c = buf->snextc();
+        }
+        if (block.size() < block_digits)
+        {
+            break;
+        }
+        piece.assign_decimal(block.data(), block.data() + block.size());
+        size_t level = STREAM_BLOCK_LEVEL;
+        for (; !pieces.empty() && pieces.back().second == level; level++)
+        {
+            big_integer& high = pieces.back().first;
+            high *= powers[level];
+            high += piece;
+            piece.number.swap(high.number);
+            pieces.pop_back();
+        }
+        pieces.emplace_back(big_integer(), level);
+        pieces.back().first.number.swap(piece.number);
+        while (!pieces.empty() && (static_cast<size_t>(9) << pieces.front().second) * FOLD_RATIO >= res_digits)
+        {
+            fold();
+        }
+    }
+    if (c == std::char_traits<char>::eof())
+    {
+        s.setstate(std::ios_base::eofbit);
+    }
+    if (res_digits == 0 && block.empty())
+    {
+        s.setstate(std::ios_base::failbit);
+        return s;
+    }
+    while (!pieces.empty())
+    {
+        fold();
+    }
+    if (!block.empty())
+    {
+        piece.assign_decimal(block.data(), block.data() + block.size());
+        if (res_digits != 0)
+        {
+            res *= pow(big_integer(10), static_cast<uint32_t>(block.size()));
+        }
+        res += piece;
+    }
+    if (negative)
+    {
+        res.negate_no_copy();
+        res.fit();
+    }
+    // the limbs are handed over when they come from the resource of a, copied otherwise
+    if (res.number.get_allocator() == a.number.get_allocator())
+    {
+        a.number.swap(res.number);
+        a.sign = res.sign;
+    }
+    else
+    {
+        a = res;
+    }
+    return s;
+}
+
+namespace
+{
+    // the stream buffer of read_decimal, refilled from the descriptor whenever it runs out
+    class fd_streambuf : public std::streambuf
+    {
+    public:
+        explicit fd_streambuf(int fd) : fd(fd) {}
+
+    protected:
+        int_type underflow() override
+        {
+            ssize_t n;
+            do
+            {
+                n = ::read(fd, buffer, sizeof(buffer));
+            } while (n < 0 && errno == EINTR);
+            if (n < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+            if (n == 0)
+            {
+                return traits_type::eof();
+            }
+            setg(buffer, buffer, buffer + n);
+            return traits_type::to_int_type(buffer[0]);
+        }
+
+    private:
+        int fd;
+        char buffer[1 << 16];
+    };
+} // namespace
+
+big_integer read_decimal(int fd)
+{
+    fd_streambuf buf(fd);
+    std::istream in(&buf);
+    // a read error is rethrown instead of only setting badbit
+    in.exceptions(std::ios_base::badbit);
+    big_integer res;
+    if (!(in >> res) || !(in >> std::ws).eof())
+    {
+        throw std::invalid_argument("Expected number");
+    }
+    return res;
+}
+
+big_integer::big_integer(big_integer_view a)
+    : number(std::max<size_t>(a.size, 1), a.sign ? UINT32_MAX : 0, big_integer_memory_resource()), sign(a.sign)
+{
+    std::copy(a.limbs, a.limbs + a.size, number.data());
+    fit();
+}
+
+big_integer_view::big_integer_view(big_integer const& a) : limbs(a.number.data()), size(a.number.size()), sign(a.sign)
+{
+}
+
+big_integer_view::big_integer_view(uint32_t const* limbs_, size_t size_, bool sign_)
+    : limbs(limbs_), size(size_), sign(sign_)
+{
+}
+
+big_integer_view big_integer_view::slice(size_t lo, size_t len) const
+{
+    lo = std::min(lo, size);
+    return {limbs + lo, std::min(len, size - lo), false};
+}
+
+namespace
+{
+    uint32_t view_limb(big_integer_view a, size_t i)
+    {
+        return i < a.size ? a.limbs[i] : a.sign ? UINT32_MAX : 0;
+    }
+
+    // res = a + b or a - b as in add_long, both operands are read up to the longer one, at least one limb,
+    // with their extensions; returns the sign of the result
+    bool add_views(limb_buffer& res, big_integer_view a, big_integer_view b, bool subtract)
+    {
+        uint32_t flip = subtract ? UINT32_MAX : 0;
+        size_t size = std::max<size_t>({a.size, b.size, 1});
+        res.assign(size, 0);
+        uint64_t carry = subtract ? 1 : 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            carry += static_cast<uint64_t>(view_limb(a, i)) + (view_limb(b, i) ^ flip);
+            res[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        int top = (a.sign ? -1 : 0) + ((b.sign != subtract) ? -1 : 0) + static_cast<int>(carry);
+        if (top == -2 || top == 1)
+        {
+            res.push_back(top == 1 ? 1 : UINT32_MAX - 1);
+        }
+        return top < 0;
+    }
+} // namespace
+
+int compare(big_integer_view a, big_integer_view b)
+{
+    BIGINT_STATS_SCOPE(compare, std::max(a.size, b.size));
+    if (a.sign != b.sign)
+    {
+        return a.sign ? -1 : 1;
+    }
+    // with the same sign, the two's complement limbs compare as unsigned ones
+    for (size_t i = std::max(a.size, b.size); i > 0; i--)
+    {
+        uint32_t x = view_limb(a, i - 1), y = view_limb(b, i - 1);
+        if (x != y)
+        {
+            return x < y ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+void add(big_integer& dst, big_integer_view a, big_integer_view b)
+{
+    BIGINT_STATS_SCOPE(add, std::max(a.size, b.size));
+    limb_buffer res(1, 0, dst.number.get_allocator());
+    bool sign = add_views(res, a, b, false);
+    dst.number.swap(res);
+    dst.sign = sign;
+}
+
+void subtract(big_integer& dst, big_integer_view a, big_integer_view b)
+{
+    BIGINT_STATS_SCOPE(sub, std::max(a.size, b.size));
+    limb_buffer res(1, 0, dst.number.get_allocator());
+    bool sign = add_views(res, a, b, true);
+    dst.number.swap(res);
+    dst.sign = sign;
+}
+
+void multiply(big_integer& dst, big_integer_view a, big_integer_view b)
+{
+    BIGINT_STATS_SCOPE(mul, std::max(a.size, b.size));
+    bool negative = a.sign != b.sign;
+    // negative operands are multiplied by their magnitudes, which takes a copy; high zero limbs are dropped
+    big_integer magnitude_a, magnitude_b;
+    if (a.sign)
+    {
+        magnitude_a = big_integer(a).abs();
+        a = magnitude_a;
+    }
+    if (b.sign)
+    {
+        magnitude_b = big_integer(b).abs();
+        b = magnitude_b;
+    }
+    while (a.size > 1 && a.limbs[a.size - 1] == 0)
+    {
+        a.size--;
+    }
+    while (b.size > 1 && b.limbs[b.size - 1] == 0)
+    {
+        b.size--;
+    }
+    limb_buffer res(std::max<size_t>(a.size + b.size, 1), 0, dst.number.get_allocator());
+    if (a.size != 0 && b.size != 0)
+    {
+        if (pool && std::min(a.size, b.size) >= options.mul_threshold)
+        {
+            mul_limbs_parallel(a.limbs, a.size, b.limbs, b.size, res.data());
+        }
+        else
+        {
+            mul_limbs_serial(a.limbs, a.size, b.limbs, b.size, res.data());
+        }
+    }
+    dst.number.swap(res);
+    dst.sign = false;
+    if (negative)
+    {
+        dst.negate_no_copy();
+    }
+}
+
+std::string to_string(big_integer_view a)
 {
-    return s << to_string(a);
+    return to_string(big_integer(a));
 }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "big_integer_view.h"
+#include "limb_buffer.h"
+#include "limb_divisor.h"
 #include <iosfwd>
+#include <iterator>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <functional>
 
@@ -11,6 +17,8 @@ struct big_integer
     big_integer(big_integer const& other);
     big_integer(int a);
     explicit big_integer(std::string const& str);
+    // copies the viewed limbs into a canonical number
+    explicit big_integer(big_integer_view a);
     big_integer(uint32_t a, bool sign);
     big_integer(uint32_t a);
     big_integer(long long a);
@@ -28,6 +36,48 @@ struct big_integer
     big_integer& operator/=(big_integer const& rhs);
     big_integer& operator%=(big_integer const& rhs);
 
+    // built-in operands work in place on the limbs without a temporary big_integer
+    big_integer& operator+=(int64_t rhs);
+    big_integer& operator+=(uint64_t rhs);
+    big_integer& operator-=(int64_t rhs);
+    big_integer& operator-=(uint64_t rhs);
+    big_integer& operator*=(int64_t rhs);
+    big_integer& operator*=(uint64_t rhs);
+    big_integer& operator/=(int64_t rhs);
+    big_integer& operator/=(uint64_t rhs);
+    big_integer& operator%=(int64_t rhs);
+    big_integer& operator%=(uint64_t rhs);
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_integer& operator+=(T rhs)
+    {
+        return *this += static_cast<scalar<T>>(rhs);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_integer& operator-=(T rhs)
+    {
+        return *this -= static_cast<scalar<T>>(rhs);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_integer& operator*=(T rhs)
+    {
+        return *this *= static_cast<scalar<T>>(rhs);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_integer& operator/=(T rhs)
+    {
+        return *this /= static_cast<scalar<T>>(rhs);
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_integer& operator%=(T rhs)
+    {
+        return *this %= static_cast<scalar<T>>(rhs);
+    }
+
     big_integer& operator&=(big_integer const& rhs);
     big_integer& operator|=(big_integer const& rhs);
     big_integer& operator^=(big_integer const& rhs);
@@ -45,6 +95,20 @@ struct big_integer
     big_integer& operator--();
     big_integer operator--(int);
 
+    // Bits of the infinite two's complement representation, a negative number has ones all the way up.
+    // The queries read the limbs in place, test_bit is O(1).
+    // bits without the sign, of x for x >= 0 and of ~x for x < 0
+    size_t bit_length() const;
+    // bits that differ from the sign
+    size_t popcount() const;
+    // index of the lowest set bit, SIZE_MAX for zero
+    size_t count_trailing_zeros() const;
+    bool test_bit(size_t pos) const;
+    big_integer& set_bit(size_t pos);
+    big_integer& clear_bit(size_t pos);
+    // bits [lo, lo + len) as a nonnegative number
+    big_integer extract_bits(size_t lo, size_t len) const;
+
     friend bool operator==(big_integer const& a, big_integer const& b);
     friend bool operator!=(big_integer const& a, big_integer const& b);
     friend bool operator<(big_integer const& a, big_integer const& b);
@@ -53,19 +117,63 @@ struct big_integer
     friend bool operator>=(big_integer const& a, big_integer const& b);
 
     friend std::string to_string(big_integer const& a);
+    friend std::ostream& operator<<(std::ostream& s, big_integer const& a);
+    friend std::istream& operator>>(std::istream& s, big_integer& a);
+
+    friend bool is_probable_prime(big_integer const& n, int rounds);
+    friend big_integer next_prime(big_integer const& n);
+    friend big_integer isqrt(big_integer const& n);
+    friend big_integer divexact(big_integer const& a, big_integer const& b);
+    friend big_integer gcd(big_integer a, big_integer b);
+    friend void add(big_integer& dst, big_integer_view a, big_integer_view b);
+    friend void subtract(big_integer& dst, big_integer_view a, big_integer_view b);
+    friend void multiply(big_integer& dst, big_integer_view a, big_integer_view b);
+
+    template <size_t Bits, bool Signed>
+    friend struct fixed_integer;
+    friend class big_integer_accumulator;
+    friend class big_rational;
+    friend class big_decimal;
+    friend class rns_integer;
+    friend class big_polynomial;
+    friend struct big_integer_view;
+    template <char... Digits>
+    friend big_integer operator""_bi();
 private:
+    template <typename T>
+    using scalar = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+    big_integer(uint32_t const* limbs, size_t size);
     void negate();
     void negate_no_copy();
-    uint32_t myAt(size_t pos);
-    big_integer& bitOp(big_integer const& rhs, std::function<uint32_t(uint32_t, uint32_t)> f);
-    uint32_t add32c(uint32_t& first, uint32_t const& second, uint32_t const& carry);
+    template <typename F>
+    big_integer& bitOp(big_integer const& rhs, F f);
+    void add_long(big_integer const& rhs, bool subtract);
     big_integer mul_long_short(uint32_t second) const;
     uint32_t div_long_short(uint32_t right);
+    uint32_t div_long_short(limb_divisor const& right);
+    void mul_add_long_short(uint32_t factor, uint32_t addend);
+    void mul_long_wide(uint64_t factor);
+    void add_scalar(uint64_t value, bool negative);
+    void mul_scalar(uint64_t magnitude, bool negative);
+    void div_scalar(uint64_t magnitude, bool negative);
+    void mod_scalar(uint64_t magnitude, bool negative);
+    void assign_decimal(char const* first, char const* last);
+    void to_decimal(char* first, char* last);
+    uint32_t mod_long_short(uint32_t right) const;
+    uint32_t mod_long_short(limb_divisor const& right) const;
+    bool miller_rabin(int rounds) const;
     big_integer abs() const;
+    // limbs up to the last one that differs from the sign extension, at least one
+    size_t significant_size() const;
+    bool is_zero() const;
     void fit();
-    big_integer reserve(const big_integer& other, size_t size);
+    void extend(size_t size);
     void myMultiply(big_integer const& left, big_integer const& right);
-    std::vector <uint32_t> number;
+    // Two's complement limbs, least significant first, continued by the sign. Their count is the tracked length
+    // the operations work on; the top ones may repeat the sign extension, they are only skipped where the value
+    // is observed, i.e. compared, written out or read as a small number.
+    limb_buffer number;
     bool sign = false;
 };
 
@@ -82,6 +190,54 @@ big_integer operator^(big_integer a, big_integer const& b);
 big_integer operator<<(big_integer a, int b);
 big_integer operator>>(big_integer a, int b);
 
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator+(big_integer a, T b)
+{
+    return a += b;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator+(T a, big_integer b)
+{
+    return b += a;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator-(big_integer a, T b)
+{
+    return a -= b;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator-(T a, big_integer b)
+{
+    return (b -= a) *= -1;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator*(big_integer a, T b)
+{
+    return a *= b;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator*(T a, big_integer b)
+{
+    return b *= a;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator/(big_integer a, T b)
+{
+    return a /= b;
+}
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+big_integer operator%(big_integer a, T b)
+{
+    return a %= b;
+}
+
 bool operator==(big_integer const& a, big_integer const& b);
 bool operator!=(big_integer const& a, big_integer const& b);
 bool operator<(big_integer const& a, big_integer const& b);
@@ -90,4 +246,72 @@ bool operator<=(big_integer const& a, big_integer const& b);
 bool operator>=(big_integer const& a, big_integer const& b);
 
 std::string to_string(big_integer const& a);
+// large numbers are written in blocks of digits as they are produced, without building the whole string
 std::ostream& operator<<(std::ostream& s, big_integer const& a);
+// reads an optional sign and decimal digits up to the first other character, parsing them in bounded blocks
+// as they are read; sets failbit and leaves a as it is when there are no digits
+std::istream& operator>>(std::istream& s, big_integer& a);
+// reads a number the same way from a file descriptor, e.g. a pipe, through a buffer of 64 KB; the descriptor is
+// read to its end and only whitespace may follow the number. Throws std::invalid_argument for anything else and
+// std::system_error when reading fails
+big_integer read_decimal(int fd);
+
+// Resource the limbs of big_integers created on this thread are allocated from
+std::pmr::memory_resource* big_integer_memory_resource();
+
+// While the scope is alive, every big_integer created on this thread, including the temporaries of the operators,
+// allocates its limbs from the given resource, e.g. a monotonic arena released at once after a computation.
+// Values built inside must not outlive the resource, copy or assign them to objects created outside.
+class big_integer_memory_scope
+{
+public:
+    explicit big_integer_memory_scope(std::pmr::memory_resource* resource);
+    ~big_integer_memory_scope();
+
+    big_integer_memory_scope(big_integer_memory_scope const&) = delete;
+    big_integer_memory_scope& operator=(big_integer_memory_scope const&) = delete;
+
+private:
+    std::pmr::memory_resource* previous;
+};
+
+// Opt-in multithreading, must not be changed while other threads are doing arithmetic
+struct parallel_options
+{
+    // number of worker threads, 0 keeps all the work on the calling thread
+    size_t threads = 0;
+    // multiplications run in parallel when both operands have at least this many limbs
+    size_t mul_threshold = 2048;
+    // Karatsuba subproducts with fewer limbs are computed by the thread that spawned them
+    size_t mul_min_task_size = 256;
+    // to_string and the string constructor split numbers with at least this many limbs
+    // into halves converted by separate tasks
+    size_t conversion_threshold = 4096;
+};
+
+void set_parallel_options(parallel_options const& options);
+parallel_options get_parallel_options();
+
+big_integer pow(big_integer base, uint32_t exp);
+// floor of the square root, throws std::invalid_argument for negative n
+big_integer isqrt(big_integer const& n);
+// a / b when b is known to divide a, faster than / as no quotient limb is estimated, the result is
+// meaningless for other operands; throws std::invalid_argument for b == 0
+big_integer divexact(big_integer const& a, big_integer const& b);
+// greatest common divisor of the absolute values, gcd(0, 0) = 0
+big_integer gcd(big_integer a, big_integer b);
+
+// Miller-Rabin test after trial division by small primes, false for n < 2
+bool is_probable_prime(big_integer const& n, int rounds = 25);
+// smallest probable prime strictly greater than n
+big_integer next_prime(big_integer const& n);
+
+// multiplies the factors through a balanced product tree
+big_integer product(std::vector<big_integer> factors);
+template <typename Range>
+big_integer product(Range const& range)
+{
+    return product(std::vector<big_integer>(std::begin(range), std::end(range)));
+}
+big_integer factorial(uint32_t n);
+big_integer binomial(uint32_t n, uint32_t k);
@@ -0,0 +1,83 @@
+#include "big_integer_accumulator.h"
+#include "big_integer_stats.h"
+
+big_integer_accumulator& big_integer_accumulator::operator+=(big_integer const& x)
+{
+    add(x, false);
+    return *this;
+}
+
+big_integer_accumulator& big_integer_accumulator::operator-=(big_integer const& x)
+{
+    add(x, true);
+    return *this;
+}
+
+// -x is added as ~x + 1, the complement has the opposite sign
+void big_integer_accumulator::add(big_integer const& x, bool subtract)
+{
+    BIGINT_STATS_SCOPE(add, x.number.size());
+    size_t size = x.number.size();
+    if (sums.size() < size + 1)
+    {
+        sums.resize(size + 1, 0);
+        borrows.resize(size + 1, 0);
+    }
+    uint32_t const* limbs = x.number.data();
+    uint64_t* dst = sums.data();
+    // separate loops without a data-dependent branch, so both are vectorized as widening additions
+    if (subtract)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            dst[i] += static_cast<uint32_t>(~limbs[i]);
+        }
+        dst[0]++;
+    }
+    else
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            dst[i] += limbs[i];
+        }
+    }
+    if (x.sign != subtract)
+    {
+        borrows[size]++;
+    }
+    if (++pending == FOLD_INTERVAL)
+    {
+        big_integer folded = value();
+        clear();
+        add(folded, false);
+    }
+}
+
+big_integer big_integer_accumulator::value() const
+{
+    big_integer res;
+    res.number.assign(sums.size(), 0);
+    // the low half of a partial sum goes into its own limb, the high half is carried into the next one
+    int64_t carry = 0;
+    for (size_t i = 0; i < sums.size(); i++)
+    {
+        int64_t t = carry + static_cast<int64_t>(sums[i] & UINT32_MAX) - static_cast<int64_t>(borrows[i]);
+        res.number[i] = static_cast<uint32_t>(t);
+        carry = (t >> 32) + static_cast<int64_t>(sums[i] >> 32);
+    }
+    while (carry != 0 && carry != -1)
+    {
+        res.number.push_back(static_cast<uint32_t>(carry));
+        carry >>= 32;
+    }
+    res.sign = carry < 0;
+    res.fit();
+    return res;
+}
+
+void big_integer_accumulator::clear()
+{
+    sums.assign(1, 0);
+    borrows.assign(1, 0);
+    pending = 0;
+}
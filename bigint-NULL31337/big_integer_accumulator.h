@@ -0,0 +1,32 @@
+#pragma once
+
+#include "big_integer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sum of many big_integers kept in carry-save form: every limb position has a 64-bit partial sum the limbs
+// of the added values go into without any carry, so an addition is one widening pass over the limbs of the
+// added value only. Carries are propagated when the value is read. Negative values are added as their
+// limbs minus 2^(32 * size), the subtracted powers are counted separately.
+class big_integer_accumulator
+{
+public:
+    big_integer_accumulator& operator+=(big_integer const& x);
+    big_integer_accumulator& operator-=(big_integer const& x);
+
+    // the sum with all carries propagated, the accumulator itself stays as it is
+    big_integer value() const;
+    void clear();
+
+private:
+    void add(big_integer const& x, bool subtract);
+
+    // partial sums grow by less than 2^32 per addition, after this many they are folded into limbs again
+    static constexpr size_t FOLD_INTERVAL = static_cast<size_t>(1) << 31;
+
+    std::vector<uint64_t> sums = std::vector<uint64_t>(1, 0);
+    // borrows[i] times 2^(32 * i) is subtracted from the sums
+    std::vector<uint64_t> borrows = std::vector<uint64_t>(1, 0);
+    size_t pending = 0;
+};
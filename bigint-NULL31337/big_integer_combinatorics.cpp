@@ -0,0 +1,125 @@
+#include "big_integer.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::vector<uint32_t> primes_up_to(uint32_t n)
+    {
+        std::vector<uint32_t> res;
+        std::vector<bool> composite(static_cast<size_t>(n) + 1, false);
+        for (uint64_t i = 2; i <= n; i++)
+        {
+            if (composite[i])
+            {
+                continue;
+            }
+            res.push_back(static_cast<uint32_t>(i));
+            for (uint64_t j = i * i; j <= n; j += i)
+            {
+                composite[j] = true;
+            }
+        }
+        return res;
+    }
+
+    // collects p^e as one-limb factors, small ones are packed together so the tree gets fewer leaves
+    struct factor_collector
+    {
+        std::vector<big_integer> factors;
+        uint64_t packed = 1;
+
+        void add(uint32_t p, uint64_t e)
+        {
+            for (; e > 0; e--)
+            {
+                if (packed * p > UINT32_MAX)
+                {
+                    factors.emplace_back(packed);
+                    packed = 1;
+                }
+                packed *= p;
+            }
+        }
+
+        big_integer result()
+        {
+            factors.emplace_back(packed);
+            packed = 1;
+            return product(std::move(factors));
+        }
+    };
+
+    // n! / ((n / 2)!)^2, the exponent of p is the number of odd values among n / p^i
+    big_integer swing(uint32_t n, std::vector<uint32_t> const& primes)
+    {
+        factor_collector collector;
+        for (size_t i = 0; i < primes.size() && primes[i] <= n; i++)
+        {
+            uint64_t e = 0;
+            for (uint32_t q = n / primes[i]; q > 0; q /= primes[i])
+            {
+                e += (q & 1);
+            }
+            collector.add(primes[i], e);
+        }
+        return collector.result();
+    }
+
+    big_integer prime_swing_factorial(uint32_t n, std::vector<uint32_t> const& primes)
+    {
+        if (n < 2)
+        {
+            return 1;
+        }
+        big_integer half = prime_swing_factorial(n / 2, primes);
+        return half * half * swing(n, primes);
+    }
+} // namespace
+
+big_integer product(std::vector<big_integer> factors)
+{
+    if (factors.empty())
+    {
+        return 1;
+    }
+    // neighbouring factors are merged level by level, so both operands of every multiplication have similar size
+    for (size_t size = factors.size(); size > 1; size = (size + 1) / 2)
+    {
+        for (size_t i = 0; i + 1 < size; i += 2)
+        {
+            factors[i / 2] = factors[i] * factors[i + 1];
+        }
+        if (size % 2 == 1)
+        {
+            factors[size / 2] = std::move(factors[size - 1]);
+        }
+    }
+    return factors[0];
+}
+
+big_integer factorial(uint32_t n)
+{
+    return prime_swing_factorial(n, primes_up_to(n));
+}
+
+big_integer binomial(uint32_t n, uint32_t k)
+{
+    if (k > n)
+    {
+        return 0;
+    }
+    factor_collector collector;
+    // Legendre: the exponent of p is the number of borrows in k + (n - k) written in base p
+    for (uint32_t p : primes_up_to(n))
+    {
+        uint64_t e = 0;
+        for (uint64_t q = p; q <= n; q *= p)
+        {
+            e += n / q - k / q - (n - k) / q;
+        }
+        collector.add(p, e);
+    }
+    return collector.result();
+}
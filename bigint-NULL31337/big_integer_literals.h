@@ -0,0 +1,79 @@
+#pragma once
+
+#include "big_integer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Digits of an integer literal converted to magnitude limbs during compilation. Decimal, hexadecimal (0x),
+// binary (0b) and octal (leading 0) literals with digit separators are accepted, anything else, e.g. a
+// floating-point literal, fails to compile because the parsing stops being a constant expression.
+template <char... Digits>
+struct big_integer_literal
+{
+    static constexpr char digits[] = {Digits...};
+    static constexpr size_t count = sizeof...(Digits);
+
+    static constexpr bool has_prefix(char lower)
+    {
+        return count > 2 && digits[0] == '0' && (digits[1] == lower || digits[1] == lower - 'a' + 'A');
+    }
+
+    static constexpr uint32_t base = has_prefix('x')                   ? 16
+                                     : has_prefix('b')                 ? 2
+                                     : (count > 1 && digits[0] == '0') ? 8
+                                                                       : 10;
+    static constexpr size_t first_digit = (base == 16 || base == 2) ? 2 : 0;
+    // no digit carries more than 4 bits
+    static constexpr size_t capacity = count * 4 / 32 + 1;
+
+    static constexpr uint32_t digit_value(char c)
+    {
+        uint32_t value = ('0' <= c && c <= '9')   ? c - '0'
+                         : ('a' <= c && c <= 'f') ? c - 'a' + 10
+                         : ('A' <= c && c <= 'F') ? c - 'A' + 10
+                                                  : base;
+        return value < base ? value : throw std::invalid_argument("invalid digit in big_integer literal");
+    }
+
+    static constexpr std::array<uint32_t, capacity> parse()
+    {
+        std::array<uint32_t, capacity> res{};
+        for (size_t i = first_digit; i < count; i++)
+        {
+            if (digits[i] == '\'')
+            {
+                continue;
+            }
+            uint64_t carry = digit_value(digits[i]);
+            for (size_t j = 0; j < capacity; j++)
+            {
+                carry += static_cast<uint64_t>(res[j]) * base;
+                res[j] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+        }
+        return res;
+    }
+
+    static constexpr std::array<uint32_t, capacity> limbs = parse();
+
+    static constexpr size_t size()
+    {
+        size_t res = capacity;
+        while (res > 1 && limbs[res - 1] == 0)
+        {
+            res--;
+        }
+        return res;
+    }
+};
+
+// 123456789012345678901234567890_bi, the value is built from the precomputed limbs without any parsing
+template <char... Digits>
+big_integer operator""_bi()
+{
+    using literal = big_integer_literal<Digits...>;
+    return big_integer(literal::limbs.data(), literal::size());
+}
@@ -0,0 +1,271 @@
+#include "big_integer.h"
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t SMALL_PRIMES_LIMIT = 4096;
+
+    struct prime_group
+    {
+        limb_divisor product;
+        size_t first;
+        size_t last;
+    };
+
+    struct small_prime_table
+    {
+        std::vector<uint32_t> primes;
+        // primes are packed into groups whose product fits into one limb,
+        // so a single pass of mod_long_short serves several primes at once
+        std::vector<prime_group> groups;
+
+        small_prime_table()
+        {
+            std::vector<bool> composite(SMALL_PRIMES_LIMIT, false);
+            for (uint32_t i = 2; i < SMALL_PRIMES_LIMIT; i++)
+            {
+                if (composite[i])
+                {
+                    continue;
+                }
+                primes.push_back(i);
+                for (uint32_t j = i * i; j < SMALL_PRIMES_LIMIT; j += i)
+                {
+                    composite[j] = true;
+                }
+            }
+            for (size_t i = 0; i < primes.size();)
+            {
+                uint32_t product = 1;
+                size_t last = i;
+                while (last < primes.size() && static_cast<uint64_t>(product) * primes[last] <= UINT32_MAX)
+                {
+                    product *= primes[last++];
+                }
+                groups.push_back({limb_divisor(product), i, last});
+                i = last;
+            }
+        }
+    };
+
+    small_prime_table const& small_primes()
+    {
+        static small_prime_table const table;
+        return table;
+    }
+
+    // Montgomery arithmetic modulo an odd k-limb number, all buffers are allocated once per modulus
+    struct montgomery
+    {
+        std::vector<uint32_t> mod;
+        uint32_t inv;
+        std::vector<uint32_t> scratch;
+
+        template <typename Limbs>
+        explicit montgomery(Limbs const& n) : mod(n.begin(), n.end()), inv(n[0]), scratch(n.size() + 2)
+        {
+            // Newton iteration doubles the number of correct low bits each step
+            for (int i = 0; i < 5; i++)
+            {
+                inv *= 2 - mod[0] * inv;
+            }
+            inv = -inv;
+        }
+
+        // out = a * b / R mod n, out may alias a or b
+        void mul(uint32_t const* a, uint32_t const* b, uint32_t* out)
+        {
+            size_t k = mod.size();
+            uint32_t* t = scratch.data();
+            std::fill(scratch.begin(), scratch.end(), 0);
+            for (size_t i = 0; i < k; i++)
+            {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < k; j++)
+                {
+                    uint64_t cur = t[j] + static_cast<uint64_t>(a[j]) * b[i] + carry;
+                    t[j] = static_cast<uint32_t>(cur);
+                    carry = cur >> 32;
+                }
+                uint64_t cur = static_cast<uint64_t>(t[k]) + carry;
+                t[k] = static_cast<uint32_t>(cur);
+                t[k + 1] = static_cast<uint32_t>(cur >> 32);
+
+                uint32_t m = t[0] * inv;
+                carry = (t[0] + static_cast<uint64_t>(m) * mod[0]) >> 32;
+                for (size_t j = 1; j < k; j++)
+                {
+                    cur = t[j] + static_cast<uint64_t>(m) * mod[j] + carry;
+                    t[j - 1] = static_cast<uint32_t>(cur);
+                    carry = cur >> 32;
+                }
+                cur = static_cast<uint64_t>(t[k]) + carry;
+                t[k - 1] = static_cast<uint32_t>(cur);
+                t[k] = t[k + 1] + static_cast<uint32_t>(cur >> 32);
+            }
+            if (t[k] != 0 || !std::lexicographical_compare(std::reverse_iterator<uint32_t*>(t + k),
+                                                           std::reverse_iterator<uint32_t*>(t),
+                                                           mod.rbegin(), mod.rend()))
+            {
+                uint32_t borrow = 0;
+                for (size_t j = 0; j < k; j++)
+                {
+                    uint64_t cur = static_cast<uint64_t>(t[j]) - mod[j] - borrow;
+                    t[j] = static_cast<uint32_t>(cur);
+                    borrow = static_cast<uint32_t>(cur >> 63);
+                }
+            }
+            std::copy(t, t + k, out);
+        }
+    };
+} // namespace
+
+bool big_integer::miller_rabin(int rounds) const
+{
+    size_t k = significant_size();
+    auto limbs = [k](big_integer const& a) {
+        std::vector<uint32_t> res(a.number.begin(), a.number.end());
+        res.resize(k, 0);
+        return res;
+    };
+
+    big_integer n_minus_one = *this - 1;
+    int s = static_cast<int>(n_minus_one.count_trailing_zeros());
+    big_integer d = n_minus_one >> s;
+    size_t d_bits = d.bit_length();
+
+    montgomery mont(limbs(*this));
+    big_integer r = (big_integer(1) << static_cast<int>(32 * k)) % *this;
+    std::vector<uint32_t> const one = limbs(r);
+    std::vector<uint32_t> const minus_one = limbs(*this - r);
+    std::vector<uint32_t> x, y;
+
+    std::mt19937 rng(number[0]);
+    big_integer base;
+    for (int round = 0; round < rounds; round++)
+    {
+        if (round == 0)
+        {
+            base = 2;
+        }
+        else
+        {
+            base.number.resize(k);
+            std::generate(base.number.begin(), base.number.end(), rng);
+            base.sign = false;
+            base.fit();
+            base %= n_minus_one - 2;
+            base += 2;
+        }
+        x = limbs((base << static_cast<int>(32 * k)) % *this);
+        y = x;
+        for (size_t i = d_bits - 1; i > 0; i--)
+        {
+            mont.mul(y.data(), y.data(), y.data());
+            if (d.test_bit(i - 1))
+            {
+                mont.mul(y.data(), x.data(), y.data());
+            }
+        }
+        if (y == one || y == minus_one)
+        {
+            continue;
+        }
+        bool witness = true;
+        for (int i = 1; i < s && witness; i++)
+        {
+            mont.mul(y.data(), y.data(), y.data());
+            if (y == minus_one)
+            {
+                witness = false;
+            }
+            else if (y == one)
+            {
+                break;
+            }
+        }
+        if (witness)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_probable_prime(big_integer const& n, int rounds)
+{
+    if (n < 2)
+    {
+        return false;
+    }
+    small_prime_table const& table = small_primes();
+    if (n < SMALL_PRIMES_LIMIT)
+    {
+        return std::binary_search(table.primes.begin(), table.primes.end(), n.number[0]);
+    }
+    for (prime_group const& group : table.groups)
+    {
+        uint32_t rem = n.mod_long_short(group.product);
+        for (size_t i = group.first; i < group.last; i++)
+        {
+            if (rem % table.primes[i] == 0)
+            {
+                return false;
+            }
+        }
+    }
+    return n.miller_rabin(rounds);
+}
+
+big_integer next_prime(big_integer const& n)
+{
+    if (n < 2)
+    {
+        return 2;
+    }
+    small_prime_table const& table = small_primes();
+    big_integer start = n + 1;
+    // prime gaps grow like ln(n), so the window is sized by the bit length
+    size_t window = std::max<size_t>(256, 4 * start.bit_length());
+    std::vector<bool> sieve;
+    while (true)
+    {
+        bool small = start < SMALL_PRIMES_LIMIT;
+        sieve.assign(window, true);
+        for (prime_group const& group : table.groups)
+        {
+            uint32_t rem = start.mod_long_short(group.product);
+            for (size_t i = group.first; i < group.last; i++)
+            {
+                uint32_t p = table.primes[i];
+                size_t pos = (p - rem % p) % p;
+                if (small && start.number[0] + pos == p)
+                {
+                    pos += p;
+                }
+                for (; pos < window; pos += p)
+                {
+                    sieve[pos] = false;
+                }
+            }
+        }
+        for (size_t i = 0; i < window; i++)
+        {
+            if (!sieve[i])
+            {
+                continue;
+            }
+            big_integer candidate = start + static_cast<unsigned long>(i);
+            // without a factor below the sieve limit anything under its square is prime
+            if (candidate < static_cast<unsigned long>(SMALL_PRIMES_LIMIT) * SMALL_PRIMES_LIMIT ||
+                candidate.miller_rabin(25))
+            {
+                return candidate;
+            }
+        }
+        start += static_cast<unsigned long>(window);
+    }
+}
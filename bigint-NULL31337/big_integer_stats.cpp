@@ -0,0 +1,140 @@
+#include "big_integer_stats.h"
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+
+namespace
+{
+    constexpr size_t OPS = static_cast<size_t>(big_integer_op::count);
+
+    char const* const op_names[OPS] = {"+", "-", "*", "/", "%", "&", "|", "^", "<<", ">>", "negate", "~", "compare",
+                                       "to_string", "parse"};
+
+    struct op_counters
+    {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> nanoseconds{0};
+        std::array<std::atomic<uint64_t>, 32> size_histogram{};
+    };
+
+    op_counters counters[OPS];
+    std::atomic<uint64_t> allocation_count{0};
+    std::atomic<uint64_t> allocation_bytes{0};
+
+    [[maybe_unused]] size_t size_bucket(size_t limbs)
+    {
+        size_t res = 0;
+        while (limbs > 1 && res + 1 < 32)
+        {
+            limbs >>= 1;
+            res++;
+        }
+        return res;
+    }
+
+    [[maybe_unused]] void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t load(std::atomic<uint64_t> const& counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+} // namespace
+
+big_integer_op_stats big_integer_stats::get(big_integer_op op)
+{
+    op_counters const& c = counters[static_cast<size_t>(op)];
+    big_integer_op_stats res;
+    res.calls = load(c.calls);
+    res.nanoseconds = load(c.nanoseconds);
+    for (size_t i = 0; i < res.size_histogram.size(); i++)
+    {
+        res.size_histogram[i] = load(c.size_histogram[i]);
+    }
+    return res;
+}
+
+uint64_t big_integer_stats::allocations()
+{
+    return load(allocation_count);
+}
+
+uint64_t big_integer_stats::allocated_bytes()
+{
+    return load(allocation_bytes);
+}
+
+void big_integer_stats::reset()
+{
+    for (op_counters& c : counters)
+    {
+        c.calls = 0;
+        c.nanoseconds = 0;
+        for (std::atomic<uint64_t>& bucket : c.size_histogram)
+        {
+            bucket = 0;
+        }
+    }
+    allocation_count = 0;
+    allocation_bytes = 0;
+}
+
+void big_integer_stats::dump()
+{
+    dump(std::cerr);
+}
+
+void big_integer_stats::dump(std::ostream& out)
+{
+    if (!enabled())
+    {
+        out << "big_integer statistics are disabled, build with BIGINT_STATS\n";
+        return;
+    }
+    out << std::left << std::setw(10) << "operation" << std::right << std::setw(14) << "calls" << std::setw(14)
+        << "total ms" << "  limbs histogram (2^k: calls)\n";
+    for (size_t i = 0; i < OPS; i++)
+    {
+        big_integer_op_stats s = get(static_cast<big_integer_op>(i));
+        if (s.calls == 0)
+        {
+            continue;
+        }
+        out << std::left << std::setw(10) << op_names[i] << std::right << std::setw(14) << s.calls << std::setw(14)
+            << std::fixed << std::setprecision(3) << s.nanoseconds / 1e6 << " ";
+        for (size_t k = 0; k < s.size_histogram.size(); k++)
+        {
+            if (s.size_histogram[k] != 0)
+            {
+                out << " " << k << ":" << s.size_histogram[k];
+            }
+        }
+        out << "\n";
+    }
+    out << "allocations: " << allocations() << ", bytes: " << allocated_bytes() << "\n";
+}
+
+#ifdef BIGINT_STATS
+big_integer_stats::scope::scope(big_integer_op op, size_t limbs) : op(op), start(std::chrono::steady_clock::now())
+{
+    op_counters& c = counters[static_cast<size_t>(op)];
+    add(c.calls, 1);
+    add(c.size_histogram[size_bucket(limbs)], 1);
+}
+
+big_integer_stats::scope::~scope()
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    add(counters[static_cast<size_t>(op)].nanoseconds,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void big_integer_stats::count_allocation(size_t bytes)
+{
+    add(allocation_count, 1);
+    add(allocation_bytes, bytes);
+}
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+enum class big_integer_op
+{
+    add,
+    sub,
+    mul,
+    div,
+    mod,
+    bit_and,
+    bit_or,
+    bit_xor,
+    shl,
+    shr,
+    neg,
+    bit_not,
+    compare,
+    to_string,
+    parse,
+    count
+};
+
+struct big_integer_op_stats
+{
+    uint64_t calls = 0;
+    // inclusive, e.g. the time of % also contains the / and * it is computed with
+    uint64_t nanoseconds = 0;
+    // bucket k counts the calls whose larger operand has [2^k, 2^(k + 1)) limbs
+    std::array<uint64_t, 32> size_histogram{};
+};
+
+// Totals of the instrumentation enabled by the BIGINT_STATS definition (the ENABLE_STATS CMake option).
+// Without it the operators are not touched at all and every counter stays zero.
+struct big_integer_stats
+{
+    static constexpr bool enabled()
+    {
+#ifdef BIGINT_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static big_integer_op_stats get(big_integer_op op);
+    // limb buffers allocated through the memory resources of big_integers and blocks of the multiplication scratch
+    static uint64_t allocations();
+    static uint64_t allocated_bytes();
+
+    static void reset();
+    // prints a table of the non-empty counters to stderr or to the given stream
+    static void dump();
+    static void dump(std::ostream& out);
+
+#ifdef BIGINT_STATS
+    // measures one operator call from construction to destruction
+    struct scope
+    {
+        scope(big_integer_op op, size_t limbs);
+        ~scope();
+
+        scope(scope const&) = delete;
+        scope& operator=(scope const&) = delete;
+
+    private:
+        big_integer_op op;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // called by the limb allocators and the scratch arena for every allocation they make
+    static void count_allocation(size_t bytes);
+#endif
+};
+
+#ifdef BIGINT_STATS
+#define BIGINT_STATS_SCOPE(op, limbs) big_integer_stats::scope stats_scope_(big_integer_op::op, limbs)
+#else
+#define BIGINT_STATS_SCOPE(op, limbs) static_cast<void>(0)
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct big_integer;
+
+// Borrowed limbs in the layout of big_integer: two's complement, least significant first, the sign stands
+// for the infinite extension. Nothing is owned or copied, the limbs must outlive the view and must not change
+// while it is used. A view may have extension limbs on top, e.g. a slice, it doesn't need to be canonical.
+struct big_integer_view
+{
+    big_integer_view(big_integer const& a);
+    big_integer_view(uint32_t const* limbs, size_t size, bool sign);
+
+    // limbs [lo, lo + len) of the stored ones as a nonnegative number, e.g. the halves of a number for
+    // a recursive algorithm; the range is clamped to the stored limbs and an empty one is zero
+    big_integer_view slice(size_t lo, size_t len) const;
+
+    uint32_t const* limbs;
+    size_t size;
+    bool sign;
+};
+
+// -1, 0 or 1 as a is less than, equal to or greater than b
+int compare(big_integer_view a, big_integer_view b);
+
+// dst = a + b, dst = a - b and dst = a * b; dst may be one of the numbers the operands view, the result
+// replaces it only after it is computed
+void add(big_integer& dst, big_integer_view a, big_integer_view b);
+void subtract(big_integer& dst, big_integer_view a, big_integer_view b);
+void multiply(big_integer& dst, big_integer_view a, big_integer_view b);
+
+std::string to_string(big_integer_view a);
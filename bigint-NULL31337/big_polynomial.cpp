@@ -0,0 +1,203 @@
+#include "big_polynomial.h"
+#include <algorithm>
+#include <utility>
+
+big_polynomial::big_polynomial() = default;
+
+big_polynomial::big_polynomial(std::vector<big_integer> coefficients) : coeffs(std::move(coefficients))
+{
+    trim();
+}
+
+void big_polynomial::trim()
+{
+    while (!coeffs.empty() && coeffs.back() == 0)
+    {
+        coeffs.pop_back();
+    }
+}
+
+size_t big_polynomial::size() const
+{
+    return coeffs.size();
+}
+
+big_integer const& big_polynomial::operator[](size_t i) const
+{
+    return coeffs[i];
+}
+
+std::vector<big_integer> const& big_polynomial::coefficients() const
+{
+    return coeffs;
+}
+
+big_integer big_polynomial::operator()(big_integer const& x) const
+{
+    big_integer res;
+    for (size_t i = coeffs.size(); i > 0; i--)
+    {
+        res *= x;
+        res += coeffs[i - 1];
+    }
+    return res;
+}
+
+big_polynomial& big_polynomial::operator+=(big_polynomial const& rhs)
+{
+    if (coeffs.size() < rhs.coeffs.size())
+    {
+        coeffs.resize(rhs.coeffs.size());
+    }
+    for (size_t i = 0; i < rhs.coeffs.size(); i++)
+    {
+        coeffs[i] += rhs.coeffs[i];
+    }
+    trim();
+    return *this;
+}
+
+big_polynomial& big_polynomial::operator-=(big_polynomial const& rhs)
+{
+    if (coeffs.size() < rhs.coeffs.size())
+    {
+        coeffs.resize(rhs.coeffs.size());
+    }
+    for (size_t i = 0; i < rhs.coeffs.size(); i++)
+    {
+        coeffs[i] -= rhs.coeffs[i];
+    }
+    trim();
+    return *this;
+}
+
+// |a_i| <= 2^A and |b_j| <= 2^B, so a coefficient of the product, a sum of at most min(n, m) products,
+// is less than 2^(A + B + L) in magnitude with L the bit length of min(n, m); one more bit is the sign
+size_t big_polynomial::slot_limbs(big_polynomial const& rhs) const
+{
+    auto max_bits = [](std::vector<big_integer> const& v) {
+        size_t res = 0;
+        for (big_integer const& c : v)
+        {
+            res = std::max(res, c.bit_length());
+        }
+        return res;
+    };
+    size_t terms = std::min(coeffs.size(), rhs.coeffs.size());
+    size_t length = 0;
+    for (; terms != 0; terms >>= 1)
+    {
+        length++;
+    }
+    size_t bits = max_bits(coeffs) + max_bits(rhs.coeffs) + length + 1;
+    return (bits + 31) / 32;
+}
+
+// The value at 2^(32 * slot): slot i gets the two's complement of a_i less the borrow of the slots below,
+// which is 1 when the slot below holds a negative value, and the whole number takes the sign of the top slot.
+big_integer big_polynomial::pack(size_t slot) const
+{
+    big_integer res;
+    res.number.assign(coeffs.size() * slot, 0);
+    uint32_t* dst = res.number.data();
+    big_integer adjusted;
+    bool borrow = false;
+    for (size_t i = 0; i < coeffs.size(); i++, dst += slot)
+    {
+        big_integer const* c = &coeffs[i];
+        if (borrow)
+        {
+            adjusted = coeffs[i];
+            adjusted -= 1;
+            c = &adjusted;
+        }
+        // the limbs above the significant ones may be more than the slot holds, they are only the extension
+        size_t size = c->significant_size();
+        std::copy(c->number.begin(), c->number.begin() + size, dst);
+        std::fill(dst + size, dst + slot, c->sign ? UINT32_MAX : 0);
+        borrow = c->sign;
+    }
+    res.sign = borrow;
+    res.fit();
+    return res;
+}
+
+// The inverse of pack: a slot with its top bit set is a negative coefficient and lends 1 to the next slot.
+void big_polynomial::unpack(big_integer const& packed, size_t count, size_t slot)
+{
+    std::vector<big_integer> res(count);
+    std::vector<uint32_t> limbs(slot);
+    uint32_t ext = packed.sign ? UINT32_MAX : 0;
+    bool carry = false;
+    for (size_t k = 0; k < count; k++)
+    {
+        for (size_t t = 0; t < slot; t++)
+        {
+            size_t i = k * slot + t;
+            limbs[t] = i < packed.number.size() ? packed.number[i] : ext;
+        }
+        bool negative = (limbs[slot - 1] >> 31) != 0;
+        res[k] = big_integer(big_integer_view(limbs.data(), slot, negative));
+        if (carry)
+        {
+            res[k] += 1;
+        }
+        carry = negative;
+    }
+    coeffs.swap(res);
+    trim();
+}
+
+big_polynomial& big_polynomial::operator*=(big_polynomial const& rhs)
+{
+    size_t n = coeffs.size(), m = rhs.coeffs.size();
+    if (n == 0 || m == 0)
+    {
+        coeffs.clear();
+        return *this;
+    }
+    if (std::min(n, m) < KRONECKER_THRESHOLD)
+    {
+        std::vector<big_integer> res(n + m - 1);
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < m; j++)
+            {
+                res[i + j] += coeffs[i] * rhs.coeffs[j];
+            }
+        }
+        coeffs.swap(res);
+        trim();
+        return *this;
+    }
+    size_t slot = slot_limbs(rhs);
+    big_integer product = pack(slot);
+    product *= &rhs == this ? product : rhs.pack(slot);
+    unpack(product, n + m - 1, slot);
+    return *this;
+}
+
+big_polynomial operator+(big_polynomial a, big_polynomial const& b)
+{
+    return a += b;
+}
+
+big_polynomial operator-(big_polynomial a, big_polynomial const& b)
+{
+    return a -= b;
+}
+
+big_polynomial operator*(big_polynomial a, big_polynomial const& b)
+{
+    return a *= b;
+}
+
+bool operator==(big_polynomial const& a, big_polynomial const& b)
+{
+    return a.coeffs == b.coeffs;
+}
+
+bool operator!=(big_polynomial const& a, big_polynomial const& b)
+{
+    return !(a == b);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "big_integer.h"
+#include <cstddef>
+#include <vector>
+
+// Polynomial with big_integer coefficients, lowest degree first. A product is computed by Kronecker
+// substitution: both factors are evaluated at 2^b, with b wide enough for every coefficient of the result,
+// by packing their coefficients into slots of b bits of one number each, the two numbers are multiplied
+// once and the coefficients are read back from the slots of the product. So a product of polynomials costs
+// one big_integer multiplication of their total size instead of one for every pair of coefficients.
+class big_polynomial
+{
+public:
+    big_polynomial();
+    // zero coefficients on top are dropped
+    big_polynomial(std::vector<big_integer> coefficients);
+
+    // number of coefficients up to the highest nonzero one, 0 for the zero polynomial
+    size_t size() const;
+    // the coefficient of x^i, i < size()
+    big_integer const& operator[](size_t i) const;
+    std::vector<big_integer> const& coefficients() const;
+    // the value at x by Horner's scheme
+    big_integer operator()(big_integer const& x) const;
+
+    big_polynomial& operator+=(big_polynomial const& rhs);
+    big_polynomial& operator-=(big_polynomial const& rhs);
+    big_polynomial& operator*=(big_polynomial const& rhs);
+
+    friend bool operator==(big_polynomial const& a, big_polynomial const& b);
+
+private:
+    void trim();
+    // limbs of a slot wide enough for every coefficient of the product with rhs
+    size_t slot_limbs(big_polynomial const& rhs) const;
+    big_integer pack(size_t slot) const;
+    void unpack(big_integer const& packed, size_t count, size_t slot);
+
+    // factors with fewer coefficients are multiplied coefficient by coefficient
+    static constexpr size_t KRONECKER_THRESHOLD = 4;
+
+    std::vector<big_integer> coeffs;
+};
+
+big_polynomial operator+(big_polynomial a, big_polynomial const& b);
+big_polynomial operator-(big_polynomial a, big_polynomial const& b);
+big_polynomial operator*(big_polynomial a, big_polynomial const& b);
+
+bool operator==(big_polynomial const& a, big_polynomial const& b);
+bool operator!=(big_polynomial const& a, big_polynomial const& b);
@@ -0,0 +1,322 @@
+#include "big_rational.h"
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+big_rational::big_rational() = default;
+
+big_rational::big_rational(big_integer const& numerator) : num(numerator), reduced_limbs(limbs()) {}
+
+big_rational::big_rational(big_integer const& numerator, big_integer const& denominator)
+    : num(numerator), den(denominator)
+{
+    if (den.is_zero())
+    {
+        throw std::invalid_argument("zero denominator");
+    }
+    if (den.sign)
+    {
+        num.negate_no_copy();
+        den.negate_no_copy();
+    }
+    reduced_limbs = limbs();
+    reduced = den == 1;
+}
+
+size_t big_rational::limbs() const
+{
+    return num.significant_size() + den.significant_size();
+}
+
+void big_rational::reduce()
+{
+    normalize();
+}
+
+// only the representation changes, the value stays the same
+void big_rational::normalize() const
+{
+    if (reduced)
+    {
+        return;
+    }
+    big_integer g = gcd(num, den);
+    if (g.significant_size() != 1 || g.number[0] != 1)
+    {
+        num = divexact(num, g);
+        den = divexact(den, g);
+    }
+    reduced_limbs = limbs();
+    reduced = true;
+}
+
+void big_rational::reduce_if_grown()
+{
+    reduced = false;
+    if (limbs() > 2 * reduced_limbs + REDUCTION_SLACK)
+    {
+        reduce();
+    }
+}
+
+big_rational& big_rational::operator+=(big_rational const& rhs)
+{
+    // sums of integers and of fractions over the same denominator need no multiplication
+    if (den == rhs.den)
+    {
+        num += rhs.num;
+    }
+    else
+    {
+        big_integer cross = rhs.num * den;
+        num *= rhs.den;
+        num += cross;
+        den *= rhs.den;
+    }
+    reduce_if_grown();
+    return *this;
+}
+
+big_rational& big_rational::operator-=(big_rational const& rhs)
+{
+    if (den == rhs.den)
+    {
+        num -= rhs.num;
+    }
+    else
+    {
+        big_integer cross = rhs.num * den;
+        num *= rhs.den;
+        num -= cross;
+        den *= rhs.den;
+    }
+    reduce_if_grown();
+    return *this;
+}
+
+big_rational& big_rational::operator*=(big_rational const& rhs)
+{
+    num *= rhs.num;
+    den *= rhs.den;
+    reduce_if_grown();
+    return *this;
+}
+
+big_rational& big_rational::operator/=(big_rational const& rhs)
+{
+    if (rhs.num.is_zero())
+    {
+        throw std::invalid_argument("division by zero");
+    }
+    // rhs may be *this, its numerator is read before it changes
+    big_integer divisor = rhs.num;
+    num *= rhs.den;
+    den *= divisor;
+    if (den.sign)
+    {
+        num.negate_no_copy();
+        den.negate_no_copy();
+    }
+    reduce_if_grown();
+    return *this;
+}
+
+big_rational big_rational::operator+() const
+{
+    return *this;
+}
+
+big_rational big_rational::operator-() const
+{
+    big_rational res(*this);
+    res.num.negate_no_copy();
+    return res;
+}
+
+big_integer big_rational::numerator() const
+{
+    normalize();
+    return num;
+}
+
+big_integer big_rational::denominator() const
+{
+    normalize();
+    return den;
+}
+
+// a.num * b.den against b.num * a.den; when the limb counts of the products are far apart,
+// the comparison is decided without multiplying
+int big_rational::compare(big_rational const& a, big_rational const& b)
+{
+    auto signum = [](big_integer const& x) {
+        return x.sign ? -1 : x.is_zero() ? 0 : 1;
+    };
+    int sa = signum(a.num), sb = signum(b.num);
+    if (sa != sb)
+    {
+        return sa < sb ? -1 : 1;
+    }
+    if (sa == 0)
+    {
+        return 0;
+    }
+    if (a.den == b.den)
+    {
+        return a.num < b.num ? -1 : b.num < a.num ? 1 : 0;
+    }
+    // a negative number may take one limb less than its magnitude, and a product of numbers with x and y limbs
+    // has x + y - 1 or x + y limbs, so products more than two limbs apart here can't be close
+    size_t left = a.num.significant_size() + b.den.significant_size();
+    size_t right = b.num.significant_size() + a.den.significant_size();
+    if (left > right + 2)
+    {
+        return sa;
+    }
+    if (right > left + 2)
+    {
+        return -sa;
+    }
+    big_integer l = a.num * b.den, r = b.num * a.den;
+    return l < r ? -1 : r < l ? 1 : 0;
+}
+
+big_rational operator+(big_rational a, big_rational const& b)
+{
+    return a += b;
+}
+
+big_rational operator-(big_rational a, big_rational const& b)
+{
+    return a -= b;
+}
+
+big_rational operator*(big_rational a, big_rational const& b)
+{
+    return a *= b;
+}
+
+big_rational operator/(big_rational a, big_rational const& b)
+{
+    return a /= b;
+}
+
+bool operator==(big_rational const& a, big_rational const& b)
+{
+    return big_rational::compare(a, b) == 0;
+}
+
+bool operator!=(big_rational const& a, big_rational const& b)
+{
+    return !(a == b);
+}
+
+bool operator<(big_rational const& a, big_rational const& b)
+{
+    return big_rational::compare(a, b) < 0;
+}
+
+bool operator>(big_rational const& a, big_rational const& b)
+{
+    return b < a;
+}
+
+bool operator<=(big_rational const& a, big_rational const& b)
+{
+    return !(a > b);
+}
+
+bool operator>=(big_rational const& a, big_rational const& b)
+{
+    return !(a < b);
+}
+
+std::string to_string(big_rational const& a)
+{
+    a.normalize();
+    if (a.den == 1)
+    {
+        return to_string(a.num);
+    }
+    return to_string(a.num) + "/" + to_string(a.den);
+}
+
+std::ostream& operator<<(std::ostream& s, big_rational const& a)
+{
+    return s << to_string(a);
+}
+
+void big_rational::write_digits(std::ostream& out, size_t digits) const
+{
+    big_integer rem = num.abs();
+    big_integer whole = rem / den;
+    rem -= whole * den;
+    // a value that truncates to zero has no sign, so with a zero whole part the '-' waits for the first nonzero
+    // digit and the zeros before it are only counted
+    bool pending_sign = num.sign && whole == 0;
+    size_t zeros = 0;
+    if (!pending_sign)
+    {
+        if (num.sign)
+        {
+            out << '-';
+        }
+        out << whole;
+        if (digits != 0)
+        {
+            out << '.';
+        }
+    }
+    // every chunk is one step of the long division, the remainder never gets longer than the denominator
+    char buffer[9];
+    for (size_t left = digits; left > 0;)
+    {
+        size_t chunk = std::min<size_t>(left, 9);
+        uint32_t scale = 1;
+        for (size_t i = 0; i < chunk; i++)
+        {
+            scale *= 10;
+        }
+        rem *= scale;
+        big_integer q = rem / den;
+        uint32_t value = q.number[0];
+        rem -= den * value;
+        for (size_t i = chunk; i > 0; i--, value /= 10)
+        {
+            buffer[i - 1] = static_cast<char>('0' + value % 10);
+        }
+        left -= chunk;
+        if (pending_sign)
+        {
+            if (q == 0)
+            {
+                zeros += chunk;
+                continue;
+            }
+            out << "-0.";
+            std::fill_n(std::ostreambuf_iterator<char>(out), zeros, '0');
+            pending_sign = false;
+        }
+        out.write(buffer, static_cast<std::streamsize>(chunk));
+    }
+    if (pending_sign)
+    {
+        out << (digits != 0 ? "0." : "0");
+        std::fill_n(std::ostreambuf_iterator<char>(out), zeros, '0');
+    }
+}
+
+std::ostream& write_decimal(std::ostream& out, big_rational const& a, size_t digits)
+{
+    a.write_digits(out, digits);
+    return out;
+}
+
+std::string to_decimal(big_rational const& a, size_t digits)
+{
+    std::ostringstream out;
+    write_decimal(out, a, digits);
+    return out.str();
+}
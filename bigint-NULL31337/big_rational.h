@@ -0,0 +1,88 @@
+#pragma once
+
+#include "big_integer.h"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+
+// Exact fraction of two big_integers with a positive denominator. The fraction is not reduced after every
+// operation: a gcd costs much more than the additions and multiplications in between, so it is only taken
+// once the limbs have doubled since the last reduction, or when the value is observed through numerator(),
+// denominator() or to_string. That reduction is done in place, so only the first observation after an
+// operation pays for the gcd; the observers are const but change the representation, so a value observed
+// from several threads at once needs a lock. Comparisons need no reduction, they cross-multiply.
+class big_rational
+{
+public:
+    big_rational();
+    big_rational(big_integer const& numerator);
+    // throws std::invalid_argument for a zero denominator
+    big_rational(big_integer const& numerator, big_integer const& denominator);
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    big_rational(T a) : big_rational(big_integer(a))
+    {
+    }
+
+    big_rational& operator+=(big_rational const& rhs);
+    big_rational& operator-=(big_rational const& rhs);
+    big_rational& operator*=(big_rational const& rhs);
+    // throws std::invalid_argument for a zero rhs
+    big_rational& operator/=(big_rational const& rhs);
+
+    big_rational operator+() const;
+    big_rational operator-() const;
+
+    // the numerator and the denominator of the reduced fraction
+    big_integer numerator() const;
+    big_integer denominator() const;
+    // divides both parts by their gcd in place, unless nothing changed them since the last reduction
+    void reduce();
+
+    friend bool operator==(big_rational const& a, big_rational const& b);
+    friend bool operator<(big_rational const& a, big_rational const& b);
+
+    friend std::string to_string(big_rational const& a);
+    friend std::ostream& write_decimal(std::ostream& out, big_rational const& a, size_t digits);
+
+private:
+    static int compare(big_rational const& a, big_rational const& b);
+    void reduce_if_grown();
+    // reduces the fraction unless it is in lowest terms already
+    void normalize() const;
+    size_t limbs() const;
+    void write_digits(std::ostream& out, size_t digits) const;
+
+    // the gcd is taken when the fraction gets twice as long as after the last reduction plus this many limbs
+    static constexpr size_t REDUCTION_SLACK = 8;
+
+    // mutable for the reduction on observation, which keeps the value
+    mutable big_integer num;
+    mutable big_integer den = 1;
+    // the size right after construction or the last reduction
+    mutable size_t reduced_limbs = 2;
+    // whether nothing changed the fraction since the last reduction
+    mutable bool reduced = true;
+};
+
+big_rational operator+(big_rational a, big_rational const& b);
+big_rational operator-(big_rational a, big_rational const& b);
+big_rational operator*(big_rational a, big_rational const& b);
+big_rational operator/(big_rational a, big_rational const& b);
+
+bool operator==(big_rational const& a, big_rational const& b);
+bool operator!=(big_rational const& a, big_rational const& b);
+bool operator<(big_rational const& a, big_rational const& b);
+bool operator>(big_rational const& a, big_rational const& b);
+bool operator<=(big_rational const& a, big_rational const& b);
+bool operator>=(big_rational const& a, big_rational const& b);
+
+// "n" for integers, "n/d" otherwise, in lowest terms
+std::string to_string(big_rational const& a);
+std::ostream& operator<<(std::ostream& s, big_rational const& a);
+
+// the value truncated toward zero to `digits` digits after the point, e.g. 1/3 to 4 digits is 0.3333;
+// the digits are produced by long division of the remainder and written out in chunks of nine
+std::ostream& write_decimal(std::ostream& out, big_rational const& a, size_t digits);
+std::string to_decimal(big_rational const& a, size_t digits);
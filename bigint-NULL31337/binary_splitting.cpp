@@ -0,0 +1,100 @@
+#include "binary_splitting.h"
+#include <cmath>
+#include <utility>
+
+binary_splitting_result binary_split(hypergeometric_series const& series, uint64_t begin, uint64_t end)
+{
+    if (end - begin == 1)
+    {
+        binary_splitting_result res{series.p(begin), series.q(begin), series.a(begin)};
+        res.t *= res.p;
+        return res;
+    }
+    uint64_t mid = begin + (end - begin) / 2;
+    binary_splitting_result left = binary_split(series, begin, mid);
+    binary_splitting_result right = binary_split(series, mid, end);
+    // T(begin, end) = T(begin, mid) * Q(mid, end) + P(begin, mid) * T(mid, end)
+    left.t *= right.q;
+    right.t *= left.p;
+    left.t += right.t;
+    left.p *= right.p;
+    left.q *= right.q;
+    return left;
+}
+
+big_integer evaluate_series(hypergeometric_series const& series, uint64_t terms, big_integer const& scale)
+{
+    binary_splitting_result res = binary_split(series, 0, terms);
+    return res.t * scale / res.q;
+}
+
+hypergeometric_series e_series()
+{
+    return {[](uint64_t) { return big_integer(1); },
+            [](uint64_t k) { return big_integer(static_cast<unsigned long long>(k == 0 ? 1 : k)); },
+            [](uint64_t) { return big_integer(1); }};
+}
+
+uint64_t e_series_terms(uint64_t digits)
+{
+    // smallest n with log10(n!) above the requested precision plus a guard digit
+    double log10_factorial = 0;
+    uint64_t n = 1;
+    while (log10_factorial < static_cast<double>(digits) + 1)
+    {
+        n++;
+        log10_factorial += std::log10(static_cast<double>(n));
+    }
+    return n + 1;
+}
+
+hypergeometric_series chudnovsky_series()
+{
+    return {[](uint64_t k) {
+                if (k == 0)
+                {
+                    return big_integer(1);
+                }
+                auto i = static_cast<unsigned long long>(k);
+                return -big_integer(6 * i - 5) * big_integer(2 * i - 1) * big_integer(6 * i - 1);
+            },
+            [](uint64_t k) {
+                if (k == 0)
+                {
+                    return big_integer(1);
+                }
+                auto i = static_cast<unsigned long long>(k);
+                // 640320^3 / 24
+                return big_integer(i) * big_integer(i) * big_integer(i) * big_integer(10939058860032000ULL);
+            },
+            [](uint64_t k) {
+                auto i = static_cast<unsigned long long>(k);
+                return big_integer(13591409ULL) + big_integer(545140134ULL) * big_integer(i);
+            }};
+}
+
+uint64_t chudnovsky_series_terms(uint64_t digits)
+{
+    return static_cast<uint64_t>(static_cast<double>(digits) / 14.181647462725477) + 2;
+}
+
+namespace
+{
+    // extra digits absorb the truncation of the series and of the square root
+    constexpr uint32_t GUARD_DIGITS = 10;
+} // namespace
+
+big_integer compute_e(uint64_t digits)
+{
+    uint64_t precision = digits + GUARD_DIGITS;
+    big_integer scale = pow(big_integer(10), static_cast<uint32_t>(precision));
+    return evaluate_series(e_series(), e_series_terms(precision), scale) / pow(big_integer(10), GUARD_DIGITS);
+}
+
+big_integer compute_pi(uint64_t digits)
+{
+    uint64_t precision = digits + GUARD_DIGITS;
+    binary_splitting_result res = binary_split(chudnovsky_series(), 0, chudnovsky_series_terms(precision));
+    big_integer root = isqrt(10005 * pow(big_integer(10), static_cast<uint32_t>(2 * precision)));
+    return 426880 * root * res.q / res.t / pow(big_integer(10), GUARD_DIGITS);
+}
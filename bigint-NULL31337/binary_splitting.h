@@ -0,0 +1,39 @@
+#pragma once
+
+#include "big_integer.h"
+#include <cstdint>
+#include <functional>
+
+// Series S = sum_{k >= 0} a(k) * p(0) * ... * p(k) / (q(0) * ... * q(k))
+struct hypergeometric_series
+{
+    std::function<big_integer(uint64_t)> p;
+    std::function<big_integer(uint64_t)> q;
+    std::function<big_integer(uint64_t)> a;
+};
+
+// P = p(begin) * ... * p(end - 1), Q = q(begin) * ... * q(end - 1)
+// and T / Q is the sum of the terms [begin, end) divided by p(0) ... p(begin - 1) / q(0) ... q(begin - 1)
+struct binary_splitting_result
+{
+    big_integer p;
+    big_integer q;
+    big_integer t;
+};
+
+binary_splitting_result binary_split(hypergeometric_series const& series, uint64_t begin, uint64_t end);
+
+// floor(scale * S) over the first `terms` terms of the series
+big_integer evaluate_series(hypergeometric_series const& series, uint64_t terms, big_integer const& scale);
+
+// sum 1 / k!, every term adds at least log10(k) digits
+hypergeometric_series e_series();
+uint64_t e_series_terms(uint64_t digits);
+
+// Chudnovsky: pi = 426880 * sqrt(10005) * Q / T, every term adds about 14.18 digits
+hypergeometric_series chudnovsky_series();
+uint64_t chudnovsky_series_terms(uint64_t digits);
+
+// floor(e * 10^digits) and floor(pi * 10^digits)
+big_integer compute_e(uint64_t digits);
+big_integer compute_pi(uint64_t digits);
@@ -238,6 +238,13 @@ std::string to_string(big_integer_gmp const& a)
     return res;
 }
 
+big_integer_gmp divexact(big_integer_gmp const& a, big_integer_gmp const& b)
+{
+    big_integer_gmp res;
+    mpz_divexact(res.mpz, a.mpz, b.mpz);
+    return res;
+}
+
 std::ostream& operator<<(std::ostream& s, big_integer_gmp const& a)
 {
     return s << to_string(a);
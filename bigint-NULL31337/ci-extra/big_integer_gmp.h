@@ -60,6 +60,7 @@ struct big_integer_gmp
     friend bool operator>=(big_integer_gmp const& a, big_integer_gmp const& b);
 
     friend std::string to_string(big_integer_gmp const& a);
+    friend big_integer_gmp divexact(big_integer_gmp const& a, big_integer_gmp const& b);
 
 private:
     mpz_t mpz;
@@ -86,4 +87,5 @@ bool operator<=(big_integer_gmp const& a, big_integer_gmp const& b);
 bool operator>=(big_integer_gmp const& a, big_integer_gmp const& b);
 
 std::string to_string(big_integer_gmp const& a);
+big_integer_gmp divexact(big_integer_gmp const& a, big_integer_gmp const& b);
 std::ostream& operator<<(std::ostream& s, big_integer_gmp const& a);
@@ -4,5 +4,5 @@ IFS=$' \t\n'
 
 mkdir -p cmake-build-$1
 rm -rf cmake-build-$1/*
-cmake -DCMAKE_BUILD_TYPE=$1 -DENABLE_SLOW_TEST=ON -S . -B cmake-build-$1
+cmake -DCMAKE_BUILD_TYPE=$1 -DENABLE_SLOW_TEST=ON "${@:2}" -S . -B cmake-build-$1
 cmake --build cmake-build-$1
@@ -0,0 +1,424 @@
+#pragma once
+
+#include "big_integer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// Integer of exactly Bits bits in two's complement, arithmetic wraps around modulo 2^Bits like the built-in
+// unsigned types. The limbs live in a std::array, every operation is constexpr, and addition, multiplication and
+// shifts are expanded over index sequences so they compile to straight-line code without loops.
+template <size_t Bits, bool Signed = true>
+struct fixed_integer
+{
+    static_assert(Bits > 0 && Bits % 32 == 0, "fixed_integer consists of whole 32-bit limbs");
+
+    static constexpr size_t LIMBS = Bits / 32;
+    using limbs_type = std::array<uint32_t, LIMBS>;
+
+    constexpr fixed_integer() : limbs{} {}
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    constexpr fixed_integer(T a) : limbs{}
+    {
+        auto value = static_cast<unsigned long long>(a);
+        uint32_t fill = (std::is_signed_v<T> && a < 0) ? UINT32_MAX : 0;
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            limbs[i] = i < 2 ? static_cast<uint32_t>(value >> (32 * i)) : fill;
+        }
+    }
+
+    // takes the value modulo 2^Bits
+    explicit fixed_integer(big_integer const& a) : limbs{}
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            limbs[i] = i < a.number.size() ? a.number[i] : (a.sign ? UINT32_MAX : 0);
+        }
+    }
+
+    explicit fixed_integer(std::string const& str) : fixed_integer(big_integer(str)) {}
+
+    explicit operator big_integer() const
+    {
+        big_integer res;
+        res.number.resize(LIMBS);
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            res.number[i] = limbs[i];
+        }
+        res.sign = is_negative();
+        res.fit();
+        return res;
+    }
+
+    constexpr fixed_integer& operator+=(fixed_integer const& rhs)
+    {
+        add(limbs, rhs.limbs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr fixed_integer& operator-=(fixed_integer const& rhs)
+    {
+        sub(limbs, rhs.limbs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr fixed_integer& operator*=(fixed_integer const& rhs)
+    {
+        limbs = mul(limbs, rhs.limbs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    // truncates towards zero like big_integer, the divisor must not be zero
+    constexpr fixed_integer& operator/=(fixed_integer const& rhs)
+    {
+        fixed_integer remainder;
+        divide(rhs, *this, remainder);
+        return *this;
+    }
+
+    constexpr fixed_integer& operator%=(fixed_integer const& rhs)
+    {
+        fixed_integer quotient;
+        divide(rhs, quotient, *this);
+        return *this;
+    }
+
+    constexpr fixed_integer& operator&=(fixed_integer const& rhs)
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            limbs[i] &= rhs.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr fixed_integer& operator|=(fixed_integer const& rhs)
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            limbs[i] |= rhs.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr fixed_integer& operator^=(fixed_integer const& rhs)
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            limbs[i] ^= rhs.limbs[i];
+        }
+        return *this;
+    }
+
+    // shifts by Bits or more give zero, or all ones for negative signed values shifted right
+    constexpr fixed_integer& operator<<=(int rhs)
+    {
+        limbs = shift_left(limbs, rhs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr fixed_integer& operator>>=(int rhs)
+    {
+        limbs = shift_right(limbs, rhs, is_negative() ? UINT32_MAX : 0, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr fixed_integer operator+() const
+    {
+        return *this;
+    }
+
+    constexpr fixed_integer operator-() const
+    {
+        fixed_integer res;
+        res -= *this;
+        return res;
+    }
+
+    constexpr fixed_integer operator~() const
+    {
+        fixed_integer res(*this);
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            res.limbs[i] = ~res.limbs[i];
+        }
+        return res;
+    }
+
+    constexpr fixed_integer& operator++()
+    {
+        return *this += 1;
+    }
+
+    constexpr fixed_integer operator++(int)
+    {
+        fixed_integer res(*this);
+        *this += 1;
+        return res;
+    }
+
+    constexpr fixed_integer& operator--()
+    {
+        return *this -= 1;
+    }
+
+    constexpr fixed_integer operator--(int)
+    {
+        fixed_integer res(*this);
+        *this -= 1;
+        return res;
+    }
+
+    friend constexpr fixed_integer operator+(fixed_integer a, fixed_integer const& b)
+    {
+        return a += b;
+    }
+
+    friend constexpr fixed_integer operator-(fixed_integer a, fixed_integer const& b)
+    {
+        return a -= b;
+    }
+
+    friend constexpr fixed_integer operator*(fixed_integer a, fixed_integer const& b)
+    {
+        return a *= b;
+    }
+
+    friend constexpr fixed_integer operator/(fixed_integer a, fixed_integer const& b)
+    {
+        return a /= b;
+    }
+
+    friend constexpr fixed_integer operator%(fixed_integer a, fixed_integer const& b)
+    {
+        return a %= b;
+    }
+
+    friend constexpr fixed_integer operator&(fixed_integer a, fixed_integer const& b)
+    {
+        return a &= b;
+    }
+
+    friend constexpr fixed_integer operator|(fixed_integer a, fixed_integer const& b)
+    {
+        return a |= b;
+    }
+
+    friend constexpr fixed_integer operator^(fixed_integer a, fixed_integer const& b)
+    {
+        return a ^= b;
+    }
+
+    friend constexpr fixed_integer operator<<(fixed_integer a, int b)
+    {
+        return a <<= b;
+    }
+
+    friend constexpr fixed_integer operator>>(fixed_integer a, int b)
+    {
+        return a >>= b;
+    }
+
+    friend constexpr bool operator==(fixed_integer const& a, fixed_integer const& b)
+    {
+        for (size_t i = 0; i < LIMBS; i++)
+        {
+            if (a.limbs[i] != b.limbs[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(fixed_integer const& a, fixed_integer const& b)
+    {
+        return !(a == b);
+    }
+
+    friend constexpr bool operator<(fixed_integer const& a, fixed_integer const& b)
+    {
+        for (size_t i = LIMBS; i > 0; i--)
+        {
+            // flipping the sign bit turns two's complement order into unsigned order
+            uint32_t flip = (Signed && i == LIMBS) ? (1u << 31) : 0;
+            if (a.limbs[i - 1] != b.limbs[i - 1])
+            {
+                return (a.limbs[i - 1] ^ flip) < (b.limbs[i - 1] ^ flip);
+            }
+        }
+        return false;
+    }
+
+    friend constexpr bool operator>(fixed_integer const& a, fixed_integer const& b)
+    {
+        return b < a;
+    }
+
+    friend constexpr bool operator<=(fixed_integer const& a, fixed_integer const& b)
+    {
+        return !(b < a);
+    }
+
+    friend constexpr bool operator>=(fixed_integer const& a, fixed_integer const& b)
+    {
+        return !(a < b);
+    }
+
+    friend std::string to_string(fixed_integer const& a)
+    {
+        return to_string(static_cast<big_integer>(a));
+    }
+
+    friend std::ostream& operator<<(std::ostream& s, fixed_integer const& a)
+    {
+        return s << to_string(a);
+    }
+
+    constexpr uint32_t limb(size_t pos) const
+    {
+        return limbs[pos];
+    }
+
+private:
+    constexpr bool is_negative() const
+    {
+        return Signed && (limbs[LIMBS - 1] >> 31) != 0;
+    }
+
+    template <size_t... I>
+    static constexpr void add(limbs_type& a, limbs_type const& b, std::index_sequence<I...>)
+    {
+        uint64_t carry = 0;
+        ((carry += static_cast<uint64_t>(a[I]) + b[I], a[I] = static_cast<uint32_t>(carry), carry >>= 32), ...);
+    }
+
+    template <size_t... I>
+    static constexpr void sub(limbs_type& a, limbs_type const& b, std::index_sequence<I...>)
+    {
+        uint64_t borrow = 0;
+        ((borrow = static_cast<uint64_t>(a[I]) - b[I] - borrow, a[I] = static_cast<uint32_t>(borrow),
+          borrow >>= 63),
+         ...);
+    }
+
+    // res[I + J] += a[J] * b for the J that stay below Bits
+    template <size_t I, size_t... J>
+    static constexpr void mul_row(limbs_type& res, limbs_type const& a, uint32_t b, std::index_sequence<J...>)
+    {
+        uint64_t carry = 0;
+        ((carry += res[I + J] + static_cast<uint64_t>(a[J]) * b, res[I + J] = static_cast<uint32_t>(carry),
+          carry >>= 32),
+         ...);
+    }
+
+    template <size_t... I>
+    static constexpr limbs_type mul(limbs_type const& a, limbs_type const& b, std::index_sequence<I...>)
+    {
+        limbs_type res{};
+        (mul_row<I>(res, a, b[I], std::make_index_sequence<LIMBS - I>{}), ...);
+        return res;
+    }
+
+    template <size_t... I>
+    static constexpr limbs_type shift_left(limbs_type const& a, int rhs, std::index_sequence<I...>)
+    {
+        size_t limb_shift = static_cast<size_t>(rhs) / 32;
+        int bit_shift = rhs % 32;
+        auto at = [&a, limb_shift](size_t i, size_t back) -> uint32_t {
+            return i >= limb_shift + back ? a[i - limb_shift - back] : 0;
+        };
+        limbs_type res{};
+        ((res[I] = bit_shift == 0 ? at(I, 0) : (at(I, 0) << bit_shift) | (at(I, 1) >> (32 - bit_shift))), ...);
+        return res;
+    }
+
+    template <size_t... I>
+    static constexpr limbs_type shift_right(limbs_type const& a, int rhs, uint32_t fill, std::index_sequence<I...>)
+    {
+        size_t limb_shift = static_cast<size_t>(rhs) / 32;
+        int bit_shift = rhs % 32;
+        auto at = [&a, limb_shift, fill](size_t i, size_t ahead) -> uint32_t {
+            return i + limb_shift + ahead < LIMBS ? a[i + limb_shift + ahead] : fill;
+        };
+        limbs_type res{};
+        ((res[I] = bit_shift == 0 ? at(I, 0) : (at(I, 0) >> bit_shift) | (at(I, 1) << (32 - bit_shift))), ...);
+        return res;
+    }
+
+    constexpr void divide(fixed_integer const& rhs, fixed_integer& quotient, fixed_integer& remainder) const
+    {
+        bool negative = is_negative(), rhs_negative = rhs.is_negative();
+        fixed_integer u = negative ? -*this : *this;
+        fixed_integer v = rhs_negative ? -rhs : rhs;
+        quotient = fixed_integer();
+        remainder = fixed_integer();
+
+        bool short_divisor = true;
+        for (size_t i = 1; i < LIMBS; i++)
+        {
+            short_divisor = short_divisor && v.limbs[i] == 0;
+        }
+        if (short_divisor)
+        {
+            uint64_t carry = 0;
+            for (size_t i = LIMBS; i > 0; i--)
+            {
+                carry = (carry << 32) | u.limbs[i - 1];
+                quotient.limbs[i - 1] = static_cast<uint32_t>(carry / v.limbs[0]);
+                carry %= v.limbs[0];
+            }
+            remainder.limbs[0] = static_cast<uint32_t>(carry);
+        }
+        else
+        {
+            // restoring division one bit at a time, the values compare as unsigned
+            for (size_t bit = Bits; bit > 0; bit--)
+            {
+                remainder.limbs = shift_left(remainder.limbs, 1, std::make_index_sequence<LIMBS>{});
+                remainder.limbs[0] |= (u.limbs[(bit - 1) / 32] >> ((bit - 1) % 32)) & 1;
+                if (!less_unsigned(remainder, v))
+                {
+                    remainder -= v;
+                    quotient.limbs[(bit - 1) / 32] |= 1u << ((bit - 1) % 32);
+                }
+            }
+        }
+        if (negative != rhs_negative)
+        {
+            quotient = -quotient;
+        }
+        if (negative)
+        {
+            remainder = -remainder;
+        }
+    }
+
+    static constexpr bool less_unsigned(fixed_integer const& a, fixed_integer const& b)
+    {
+        for (size_t i = LIMBS; i > 0; i--)
+        {
+            if (a.limbs[i - 1] != b.limbs[i - 1])
+            {
+                return a.limbs[i - 1] < b.limbs[i - 1];
+            }
+        }
+        return false;
+    }
+
+    limbs_type limbs;
+};
+
+using int128 = fixed_integer<128, true>;
+using uint128 = fixed_integer<128, false>;
+using int256 = fixed_integer<256, true>;
+using uint256 = fixed_integer<256, false>;
+using int512 = fixed_integer<512, true>;
+using uint512 = fixed_integer<512, false>;
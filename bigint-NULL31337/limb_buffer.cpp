@@ -0,0 +1,81 @@
+#include "limb_buffer.h"
+
+#ifdef BIGINT_COPY_ON_WRITE
+
+#include <new>
+#include <utility>
+
+limb_buffer::block* limb_buffer::create(limb_vector limbs)
+{
+    // the block lives in the same resource as the limbs
+    std::allocator_traits<allocator_type>::rebind_alloc<block> alloc(limbs.get_allocator());
+    block* res = alloc.allocate(1);
+    new (res) block{{1}, std::move(limbs)};
+    return res;
+}
+
+void limb_buffer::release(block* b)
+{
+    if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        std::allocator_traits<allocator_type>::rebind_alloc<block> alloc(b->limbs.get_allocator());
+        b->~block();
+        alloc.deallocate(b, 1);
+    }
+}
+
+limb_buffer::limb_buffer(size_t count, uint32_t value, allocator_type const& alloc)
+    : shared(create(limb_vector(count, value, alloc)))
+{
+}
+
+limb_buffer::limb_buffer(limb_buffer const& other, allocator_type const& alloc)
+{
+    if (other.get_allocator() == alloc)
+    {
+        shared = other.shared;
+        shared->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        shared = create(limb_vector(other.shared->limbs, alloc));
+    }
+}
+
+limb_buffer::limb_buffer(limb_buffer const& other) : limb_buffer(other, other.get_allocator()) {}
+
+limb_buffer& limb_buffer::operator=(limb_buffer const& other)
+{
+    if (shared == other.shared)
+    {
+        return *this;
+    }
+    if (get_allocator() == other.get_allocator())
+    {
+        other.shared->refs.fetch_add(1, std::memory_order_relaxed);
+        release(shared);
+        shared = other.shared;
+    }
+    else
+    {
+        // like a pmr vector, the buffer keeps its own resource
+        block* copy = create(limb_vector(other.shared->limbs, get_allocator()));
+        release(shared);
+        shared = copy;
+    }
+    return *this;
+}
+
+limb_buffer::~limb_buffer()
+{
+    release(shared);
+}
+
+void limb_buffer::detach()
+{
+    block* copy = create(limb_vector(shared->limbs, get_allocator()));
+    release(shared);
+    shared = copy;
+}
+
+#endif
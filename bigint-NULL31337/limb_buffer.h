@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#ifdef BIGINT_STATS
+
+#include "big_integer_stats.h"
+
+// polymorphic_allocator that reports what it allocates to big_integer_stats; allocators compare equal when their
+// resources do, as without the statistics
+template <typename T>
+struct counting_allocator : std::pmr::polymorphic_allocator<T>
+{
+    using std::pmr::polymorphic_allocator<T>::polymorphic_allocator;
+
+    counting_allocator(std::pmr::polymorphic_allocator<T> const& other) noexcept
+        : std::pmr::polymorphic_allocator<T>(other)
+    {
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = counting_allocator<U>;
+    };
+
+    T* allocate(size_t n)
+    {
+        big_integer_stats::count_allocation(n * sizeof(T));
+        return std::pmr::polymorphic_allocator<T>::allocate(n);
+    }
+};
+
+using limb_vector = std::vector<uint32_t, counting_allocator<uint32_t>>;
+
+#else
+
+using limb_vector = std::pmr::vector<uint32_t>;
+
+#endif
+
+#ifndef BIGINT_COPY_ON_WRITE
+
+using limb_buffer = limb_vector;
+
+#else
+
+#include <atomic>
+
+// Limb vector whose copies share one reference-counted buffer. Every non-const member makes the buffer
+// unique first, so the real copy happens on the first mutation. Buffers are shared only between copies
+// using the same memory resource, a copy into another resource is made eagerly.
+class limb_buffer
+{
+public:
+    using value_type = uint32_t;
+    using allocator_type = limb_vector::allocator_type;
+    using iterator = uint32_t*;
+    using const_iterator = uint32_t const*;
+
+    limb_buffer(size_t count, uint32_t value, allocator_type const& alloc);
+    limb_buffer(limb_buffer const& other, allocator_type const& alloc);
+    limb_buffer(limb_buffer const& other);
+    limb_buffer& operator=(limb_buffer const& other);
+    ~limb_buffer();
+
+    allocator_type get_allocator() const
+    {
+        return shared->limbs.get_allocator();
+    }
+
+    size_t size() const
+    {
+        return shared->limbs.size();
+    }
+
+    bool empty() const
+    {
+        return shared->limbs.empty();
+    }
+
+    uint32_t const* data() const
+    {
+        return shared->limbs.data();
+    }
+
+    uint32_t* data()
+    {
+        return unique().data();
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + size();
+    }
+
+    uint32_t const& operator[](size_t pos) const
+    {
+        return shared->limbs[pos];
+    }
+
+    uint32_t& operator[](size_t pos)
+    {
+        return unique()[pos];
+    }
+
+    uint32_t const& back() const
+    {
+        return shared->limbs.back();
+    }
+
+    uint32_t& back()
+    {
+        return unique().back();
+    }
+
+    void push_back(uint32_t value)
+    {
+        unique().push_back(value);
+    }
+
+    void pop_back()
+    {
+        unique().pop_back();
+    }
+
+    void resize(size_t count)
+    {
+        unique().resize(count);
+    }
+
+    void resize(size_t count, uint32_t value)
+    {
+        unique().resize(count, value);
+    }
+
+    void assign(size_t count, uint32_t value)
+    {
+        unique().assign(count, value);
+    }
+
+    iterator insert(const_iterator pos, size_t count, uint32_t value)
+    {
+        size_t index = pos - data();
+        limb_vector& limbs = unique();
+        limbs.insert(limbs.begin() + index, count, value);
+        return limbs.data() + index;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_t from = first - data(), to = last - data();
+        limb_vector& limbs = unique();
+        limbs.erase(limbs.begin() + from, limbs.begin() + to);
+        return limbs.data() + from;
+    }
+
+    void swap(limb_buffer& other) noexcept
+    {
+        std::swap(shared, other.shared);
+    }
+
+private:
+    struct block
+    {
+        std::atomic<size_t> refs;
+        limb_vector limbs;
+    };
+
+    static block* create(limb_vector limbs);
+    static void release(block* b);
+    limb_vector& unique()
+    {
+        if (shared->refs.load(std::memory_order_acquire) != 1)
+        {
+            detach();
+        }
+        return shared->limbs;
+    }
+    void detach();
+
+    block* shared;
+};
+
+#endif
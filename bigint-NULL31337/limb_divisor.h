@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Divisor of one limb with a precomputed reciprocal (Moller, Granlund, "Improved division by invariant
+// integers"), a division of two limbs by it takes two multiplications instead of a hardware division.
+// Computing the reciprocal costs one division, so it pays off as soon as the same divisor is used
+// for a whole number or is stored for repeated use.
+struct limb_divisor
+{
+    constexpr explicit limb_divisor(uint32_t divisor)
+        : value(divisor), shift(leading_zeros(divisor)), normalized(divisor << shift),
+          inverse(static_cast<uint32_t>(UINT64_MAX / normalized - (static_cast<uint64_t>(1) << 32)))
+    {
+    }
+
+    // (high * 2^32 + low) / normalized, high must be less than normalized
+    constexpr uint32_t divide(uint32_t high, uint32_t low, uint32_t& remainder) const
+    {
+        uint64_t q = static_cast<uint64_t>(inverse) * high + ((static_cast<uint64_t>(high) << 32) | low);
+        uint32_t q1 = static_cast<uint32_t>(q >> 32) + 1;
+        uint32_t r = low - q1 * normalized;
+        // taken about half of the time, so it is done with a mask instead of a branch
+        uint32_t mask = 0 - static_cast<uint32_t>(r > static_cast<uint32_t>(q));
+        q1 += mask;
+        r += mask & normalized;
+        if (r >= normalized)
+        {
+            q1++;
+            r -= normalized;
+        }
+        remainder = r;
+        return q1;
+    }
+
+    // divides the limbs in place and returns the remainder
+    uint32_t divide(uint32_t* limbs, size_t size) const
+    {
+        return run(limbs, size, [limbs](size_t i, uint32_t q) { limbs[i] = q; });
+    }
+
+    uint32_t remainder(uint32_t const* limbs, size_t size) const
+    {
+        return run(limbs, size, [](size_t, uint32_t) {});
+    }
+
+    uint32_t value;
+    int shift;
+    uint32_t normalized;
+    uint32_t inverse;
+
+private:
+    // the dividend is shifted together with the divisor, the bits above the top limb start the remainder
+    template <typename Store>
+    uint32_t run(uint32_t const* limbs, size_t size, Store store) const
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+        uint32_t r = 0;
+        if (shift == 0)
+        {
+            for (size_t i = size; i > 0; i--)
+            {
+                store(i - 1, divide(r, limbs[i - 1], r));
+            }
+            return r;
+        }
+        r = limbs[size - 1] >> (32 - shift);
+        for (size_t i = size - 1; i > 0; i--)
+        {
+            uint32_t low = (limbs[i] << shift) | (limbs[i - 1] >> (32 - shift));
+            store(i, divide(r, low, r));
+        }
+        store(0, divide(r, limbs[0] << shift, r));
+        return r >> shift;
+    }
+
+    static constexpr int leading_zeros(uint32_t a)
+    {
+        int res = 0;
+        for (uint32_t bit = 1u << 31; bit != 0 && (a & bit) == 0; bit >>= 1)
+        {
+            res++;
+        }
+        return res;
+    }
+};
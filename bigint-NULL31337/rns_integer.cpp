@@ -0,0 +1,318 @@
+#include "rns_integer.h"
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    constexpr uint32_t MODULUS_LIMIT = static_cast<uint32_t>(1) << 31;
+
+    // t * 2^-32 mod p for t < p * 2^32; branch-free apart from the final select, so loops over the moduli
+    // vectorize
+    inline uint32_t montgomery_reduce(uint64_t t, uint32_t p, uint32_t neg_inverse)
+    {
+        uint32_t m = static_cast<uint32_t>(t) * neg_inverse;
+        uint32_t u = static_cast<uint32_t>((t + static_cast<uint64_t>(m) * p) >> 32);
+        return u >= p ? u - p : u;
+    }
+
+    inline uint32_t montgomery_multiply(uint32_t a, uint32_t b, uint32_t p, uint32_t neg_inverse)
+    {
+        return montgomery_reduce(static_cast<uint64_t>(a) * b, p, neg_inverse);
+    }
+
+    uint32_t pow_mod(uint64_t base, uint32_t exponent, uint32_t m)
+    {
+        uint64_t res = 1;
+        for (base %= m; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+            {
+                res = res * base % m;
+            }
+            base = base * base % m;
+        }
+        return static_cast<uint32_t>(res);
+    }
+
+    // Miller-Rabin with the bases 2, 7 and 61 is exact below 2^32
+    bool is_prime(uint32_t n)
+    {
+        if (n < 2 || n % 2 == 0)
+        {
+            return n == 2;
+        }
+        uint32_t d = n - 1;
+        int s = 0;
+        for (; d % 2 == 0; d /= 2)
+        {
+            s++;
+        }
+        for (uint32_t a : {2u, 7u, 61u})
+        {
+            if (a % n == 0)
+            {
+                continue;
+            }
+            uint64_t x = pow_mod(a, d, n);
+            if (x == 1 || x == n - 1)
+            {
+                continue;
+            }
+            bool composite = true;
+            for (int i = 1; i < s && composite; i++)
+            {
+                x = x * x % n;
+                composite = x != n - 1;
+            }
+            if (composite)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // a^-1 mod m by the extended Euclidean algorithm, 0 when a and m have a common factor
+    uint32_t inverse_mod(uint32_t a, uint32_t m)
+    {
+        int64_t r0 = m, r1 = a % m, t0 = 0, t1 = 1;
+        while (r1 != 0)
+        {
+            int64_t q = r0 / r1;
+            r0 = std::exchange(r1, r0 - q * r1);
+            t0 = std::exchange(t1, t0 - q * t1);
+        }
+        if (r0 != 1)
+        {
+            return 0;
+        }
+        return static_cast<uint32_t>(t0 < 0 ? t0 + m : t0);
+    }
+} // namespace
+
+rns_basis::rns_basis(std::vector<uint32_t> moduli_) : moduli(std::move(moduli_)), full_product(1)
+{
+    if (moduli.empty())
+    {
+        throw std::invalid_argument("empty rns basis");
+    }
+    for (size_t i = 0; i < moduli.size(); i++)
+    {
+        uint32_t p = moduli[i];
+        if (p < 3 || p >= MODULUS_LIMIT || p % 2 == 0)
+        {
+            throw std::invalid_argument("rns moduli must be odd and between 3 and 2^31");
+        }
+        // Newton's iteration doubles the correct low bits, p * p = 1 mod 8 gives the first three
+        uint32_t inverse = p;
+        for (int step = 0; step < 4; step++)
+        {
+            inverse *= 2 - p * inverse;
+        }
+        neg_inverses.push_back(0 - inverse);
+        uint64_t r = (static_cast<uint64_t>(1) << 32) % p;
+        r2.push_back(static_cast<uint32_t>(r * r % p));
+        divisors.emplace_back(p);
+        full_product *= p;
+    }
+    half_product = full_product >> 1;
+    for (size_t j = 0; j < moduli.size(); j++)
+    {
+        for (size_t i = j + 1; i < moduli.size(); i++)
+        {
+            uint32_t inverse = inverse_mod(moduli[j], moduli[i]);
+            if (inverse == 0)
+            {
+                throw std::invalid_argument("rns moduli must be pairwise coprime");
+            }
+            garner_inverses.push_back(static_cast<uint32_t>((static_cast<uint64_t>(inverse) << 32) % moduli[i]));
+        }
+    }
+}
+
+rns_basis rns_basis::for_bits(size_t bits)
+{
+    std::vector<uint32_t> primes;
+    big_integer product = 1;
+    for (uint32_t candidate = MODULUS_LIMIT - 1; product.bit_length() <= bits + 1; candidate -= 2)
+    {
+        if (is_prime(candidate))
+        {
+            primes.push_back(candidate);
+            product *= candidate;
+        }
+    }
+    return rns_basis(std::move(primes));
+}
+
+size_t rns_basis::size() const
+{
+    return moduli.size();
+}
+
+uint32_t rns_basis::modulus(size_t i) const
+{
+    return moduli[i];
+}
+
+big_integer const& rns_basis::product() const
+{
+    return full_product;
+}
+
+rns_integer::rns_integer(rns_basis const& basis, big_integer const& value) : base(&basis), residues(basis.size())
+{
+    big_integer magnitude = value.abs();
+    for (size_t i = 0; i < residues.size(); i++)
+    {
+        uint32_t p = basis.moduli[i];
+        uint32_t r = magnitude.mod_long_short(basis.divisors[i]);
+        if (value.sign && r != 0)
+        {
+            r = p - r;
+        }
+        residues[i] = montgomery_multiply(r, basis.r2[i], p, basis.neg_inverses[i]);
+    }
+}
+
+void rns_integer::check_basis(rns_integer const& rhs) const
+{
+    if (base != rhs.base)
+    {
+        throw std::invalid_argument("rns_integers over different bases");
+    }
+}
+
+rns_integer& rns_integer::operator+=(rns_integer const& rhs)
+{
+    check_basis(rhs);
+    uint32_t const* p = base->moduli.data();
+    uint32_t const* b = rhs.residues.data();
+    uint32_t* a = residues.data();
+    for (size_t i = 0, size = residues.size(); i < size; i++)
+    {
+        uint32_t sum = a[i] + b[i];
+        a[i] = sum >= p[i] ? sum - p[i] : sum;
+    }
+    return *this;
+}
+
+rns_integer& rns_integer::operator-=(rns_integer const& rhs)
+{
+    check_basis(rhs);
+    uint32_t const* p = base->moduli.data();
+    uint32_t const* b = rhs.residues.data();
+    uint32_t* a = residues.data();
+    for (size_t i = 0, size = residues.size(); i < size; i++)
+    {
+        // the same shape as the sum, which the compiler vectorizes where it doesn't with a comparison of a and b
+        uint32_t difference = a[i] + p[i] - b[i];
+        a[i] = difference >= p[i] ? difference - p[i] : difference;
+    }
+    return *this;
+}
+
+rns_integer& rns_integer::operator*=(rns_integer const& rhs)
+{
+    check_basis(rhs);
+    uint32_t const* p = base->moduli.data();
+    uint32_t const* n = base->neg_inverses.data();
+    uint32_t const* b = rhs.residues.data();
+    uint32_t* a = residues.data();
+    for (size_t i = 0, size = residues.size(); i < size; i++)
+    {
+        a[i] = montgomery_multiply(a[i], b[i], p[i], n[i]);
+    }
+    return *this;
+}
+
+rns_integer rns_integer::operator+() const
+{
+    return *this;
+}
+
+rns_integer rns_integer::operator-() const
+{
+    rns_integer res(*this);
+    uint32_t const* p = base->moduli.data();
+    uint32_t* a = res.residues.data();
+    for (size_t i = 0, size = res.residues.size(); i < size; i++)
+    {
+        uint32_t difference = p[i] - a[i];
+        a[i] = difference >= p[i] ? difference - p[i] : difference;
+    }
+    return res;
+}
+
+rns_basis const& rns_integer::basis() const
+{
+    return *base;
+}
+
+uint32_t rns_integer::residue(size_t i) const
+{
+    return montgomery_reduce(residues[i], base->moduli[i], base->neg_inverses[i]);
+}
+
+// Garner's algorithm gives the digits of the value in the mixed radix of the moduli, so the value itself
+// is a Horner scheme of one-limb multiply-adds. Every digit is taken out of all the later residues at once,
+// in Montgomery form, so that inner loop vectorizes like the arithmetic and has no division.
+big_integer rns_integer::to_big_integer() const
+{
+    size_t size = residues.size();
+    uint32_t const* p = base->moduli.data();
+    uint32_t const* n = base->neg_inverses.data();
+    uint32_t const* r2 = base->r2.data();
+    std::vector<uint32_t> rest(residues.begin(), residues.end());
+    uint32_t* t = rest.data();
+    std::vector<uint32_t> digits(size);
+    uint32_t const* inverses = base->garner_inverses.data();
+    for (size_t j = 0; j < size; j++)
+    {
+        uint32_t digit = montgomery_reduce(t[j], p[j], n[j]);
+        digits[j] = digit;
+        // the digit is below 2^31, so its Montgomery form mod a smaller modulus is one reduction too
+        for (size_t i = j + 1; i < size; i++)
+        {
+            uint32_t d = montgomery_multiply(digit, r2[i], p[i], n[i]);
+            t[i] = montgomery_multiply(t[i] + p[i] - d, inverses[i - j - 1], p[i], n[i]);
+        }
+        inverses += size - j - 1;
+    }
+    big_integer res = digits[size - 1];
+    for (size_t i = size - 1; i > 0; i--)
+    {
+        res.mul_add_long_short(p[i - 1], digits[i - 1]);
+    }
+    if (res > base->half_product)
+    {
+        res -= base->full_product;
+    }
+    return res;
+}
+
+rns_integer operator+(rns_integer a, rns_integer const& b)
+{
+    return a += b;
+}
+
+rns_integer operator-(rns_integer a, rns_integer const& b)
+{
+    return a -= b;
+}
+
+rns_integer operator*(rns_integer a, rns_integer const& b)
+{
+    return a *= b;
+}
+
+bool operator==(rns_integer const& a, rns_integer const& b)
+{
+    a.check_basis(b);
+    return a.residues == b.residues;
+}
+
+bool operator!=(rns_integer const& a, rns_integer const& b)
+{
+    return !(a == b);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "big_integer.h"
+#include "limb_divisor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set of odd pairwise coprime moduli below 2^31, usually primes, with everything precomputed that
+// rns_integer needs for arithmetic in Montgomery form and for the reconstruction.
+class rns_basis
+{
+public:
+    // throws std::invalid_argument for an empty set, an even or too large modulus, or moduli with a common factor
+    explicit rns_basis(std::vector<uint32_t> moduli);
+
+    // the largest primes below 2^31 whose product exceeds 2^(bits + 1), so that every value of at most `bits`
+    // bits and either sign is represented
+    static rns_basis for_bits(size_t bits);
+
+    size_t size() const;
+    uint32_t modulus(size_t i) const;
+    // values are reconstructed into (-product / 2, product / 2]
+    big_integer const& product() const;
+
+private:
+    friend class rns_integer;
+
+    std::vector<uint32_t> moduli;
+    // -modulus^-1 mod 2^32 and 2^64 mod modulus, for the Montgomery reductions
+    std::vector<uint32_t> neg_inverses;
+    std::vector<uint32_t> r2;
+    std::vector<limb_divisor> divisors;
+    // for Garner's algorithm the inverses of moduli[j] mod every later modulus in Montgomery form, one run
+    // for every j
+    std::vector<uint32_t> garner_inverses;
+    big_integer full_product;
+    big_integer half_product;
+};
+
+// Integer kept as its residues modulo the moduli of a basis. Addition, subtraction and multiplication work
+// on every residue independently, in loops over the moduli the compiler vectorizes, so long chains of them
+// on numbers of bounded size cost no carries and no big multiplications; the integer is reconstructed once
+// by the Chinese remainder theorem at the end. Results are only correct while every intermediate value fits
+// into the range of the basis, nothing detects an overflow. The basis must outlive the numbers built on it,
+// operands of a binary operation must share it or std::invalid_argument is thrown.
+class rns_integer
+{
+public:
+    rns_integer(rns_basis const& basis, big_integer const& value);
+
+    rns_integer& operator+=(rns_integer const& rhs);
+    rns_integer& operator-=(rns_integer const& rhs);
+    rns_integer& operator*=(rns_integer const& rhs);
+
+    rns_integer operator+() const;
+    rns_integer operator-() const;
+
+    rns_basis const& basis() const;
+    // the residue modulo basis().modulus(i)
+    uint32_t residue(size_t i) const;
+    big_integer to_big_integer() const;
+
+    friend bool operator==(rns_integer const& a, rns_integer const& b);
+
+private:
+    void check_basis(rns_integer const& rhs) const;
+
+    rns_basis const* base;
+    // in Montgomery form, residue * 2^32 mod modulus
+    std::vector<uint32_t> residues;
+};
+
+rns_integer operator+(rns_integer a, rns_integer const& b);
+rns_integer operator-(rns_integer a, rns_integer const& b);
+rns_integer operator*(rns_integer a, rns_integer const& b);
+
+bool operator==(rns_integer const& a, rns_integer const& b);
+bool operator!=(rns_integer const& a, rns_integer const& b);
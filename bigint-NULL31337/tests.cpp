@@ -1,11 +1,24 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <iomanip>
 #include <string>
 #include <limits>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
 #include <gtest/gtest.h>
 
 #include "big_integer.h"
+#include "big_decimal.h"
+#include "big_integer_accumulator.h"
+#include "big_integer_literals.h"
+#include "big_integer_stats.h"
+#include "big_polynomial.h"
+#include "big_rational.h"
+#include "binary_splitting.h"
+#include "fixed_integer.h"
+#include "rns_integer.h"
 
 TEST(correctness, two_plus_two)
 {
@@ -333,6 +346,112 @@ TEST(correctness, decrement)
     EXPECT_EQ(41, post);
 }
 
+TEST(correctness, increment_decrement_carry)
+{
+    std::vector<big_integer> values = {0, 1, -1, -2, big_integer(UINT32_MAX), -big_integer(UINT32_MAX),
+                                       big_integer(1) << 32, -(big_integer(1) << 32), (big_integer(1) << 96) - 1,
+                                       -(big_integer(1) << 96), -(big_integer(1) << 96) + 1, big_integer(1) << 96};
+    for (big_integer const& value : values)
+    {
+        big_integer a = value, b = value;
+        EXPECT_EQ(value + 1, ++a);
+        EXPECT_EQ(value - 1, --b);
+        EXPECT_EQ(value, --a);
+        EXPECT_EQ(value, ++b);
+    }
+    big_integer c = -3;
+    for (int i = 0; i < 6; i++)
+    {
+        c++;
+    }
+    EXPECT_EQ(3, c);
+}
+
+TEST(correctness, sign_extension_boundaries)
+{
+    big_integer const p32 = big_integer(1) << 32, p64 = big_integer(1) << 64;
+    std::vector<big_integer> values = {0, 1, -1, big_integer(UINT32_MAX), -big_integer(UINT32_MAX), p32, -p32,
+                                       p64 - 1, -p64, -p64 + 1, p64, -(p64 << 32) - 1};
+    for (big_integer const& a : values)
+    {
+        for (big_integer const& b : values)
+        {
+            EXPECT_EQ(a, (a + b) - b);
+            EXPECT_EQ(a, (a - b) + b);
+            EXPECT_EQ(a + b, b + a);
+            EXPECT_EQ(a - b, -(b - a));
+            EXPECT_EQ(a, (a ^ b) ^ b);
+            EXPECT_EQ(a + b, (a & b) + (a | b));
+            EXPECT_EQ(to_string(a + b), to_string(b - -a));
+        }
+        big_integer twice = a, none = a;
+        twice += twice;
+        none -= none;
+        EXPECT_EQ(a * 2, twice);
+        EXPECT_EQ(0, none);
+    }
+    EXPECT_EQ("-4294967296", to_string(big_integer(UINT32_MAX) ^ -1));
+    EXPECT_EQ("-4294967296", to_string(~big_integer(UINT32_MAX)));
+    EXPECT_EQ("18446744073709551616", to_string(-(-p64)));
+    EXPECT_EQ("-18446744073709551616", to_string(-p32 - (p64 - p32)));
+}
+
+// the operators keep the limbs they worked on, values that cancel down carry extension limbs on top
+TEST(correctness, lazy_normalization)
+{
+    big_integer const big = pow(big_integer(3), 700);
+    big_integer zero = big - big, five = (big + 5) - big, minus_one = (big - 1) - big;
+    EXPECT_EQ(0, zero);
+    EXPECT_EQ(big_integer(), zero);
+    EXPECT_EQ("0", to_string(zero));
+    EXPECT_FALSE(zero < 0);
+    EXPECT_FALSE(0 < zero);
+    EXPECT_EQ(5, five);
+    EXPECT_TRUE(five < big);
+    EXPECT_TRUE(big > five);
+    EXPECT_TRUE(minus_one < zero);
+    EXPECT_EQ("-1", to_string(minus_one));
+    EXPECT_EQ(-1, minus_one);
+
+    EXPECT_EQ(0, zero * big);
+    EXPECT_EQ(big * 5, five * big);
+    EXPECT_EQ(big / 5, big / five);
+    EXPECT_EQ(big % 5, big % five);
+    EXPECT_EQ(big_integer(7) / 5, ((big + 7) - big) / five);
+    EXPECT_EQ(2, divexact((big + 10) - big, five));
+    EXPECT_EQ(5, gcd(big * 5, five));
+    EXPECT_EQ(5, gcd(five, (big + 15) - big));
+    EXPECT_EQ(3, isqrt((big + 9) - big));
+    EXPECT_EQ(2, five.bit_length() - 1);
+    EXPECT_TRUE(is_probable_prime(five));
+    EXPECT_EQ(7, next_prime(five));
+
+    // -2^31 - 2^31 fits the single limb 0 with the sign set, i.e. -2^32
+    big_integer low = -(big_integer(1) << 31);
+    big_integer p32 = low + low;
+    EXPECT_EQ(-(big_integer(1) << 32), p32);
+    EXPECT_EQ("-4294967296", to_string(p32));
+    EXPECT_EQ(32u, p32.count_trailing_zeros());
+    EXPECT_EQ(big_integer(3) % (big_integer(1) << 32), big_integer(3) % p32);
+    EXPECT_TRUE(p32 < low);
+
+    // shifting back and forth doesn't change the value
+    big_integer x = five;
+    for (int i = 0; i < 100; i++)
+    {
+        x <<= 1;
+        x >>= 1;
+    }
+    EXPECT_EQ(5, x);
+
+    big_rational r(five, (big + 10) - big);
+    EXPECT_EQ("1/2", to_string(r));
+    big_polynomial p({five, (big + 3) - big, minus_one, zero - 2, five});
+    big_polynomial q({5, 3, -1, -2, 5});
+    EXPECT_EQ(q * q, p * p);
+    EXPECT_EQ("5", to_string(big_decimal(five, 0)));
+}
+
 TEST(correctness, and_)
 {
     big_integer a = 0x55;
@@ -679,6 +798,49 @@ TEST(correctness, string_conv)
     EXPECT_EQ("-2147483649", to_string(lim));
 }
 
+TEST(correctness, stream_conv)
+{
+    // past 1024 limbs the output is written in blocks, the zeros inside 10^k + 7 pad the lower blocks;
+    // the upper half of 10^48080 is much shorter than the lower one
+    std::vector<big_integer> values = {0, -1, 123, big_integer("-1000000000000000"), pow(big_integer(3), 30000),
+                                       -pow(big_integer(3), 30000), pow(big_integer(10), 40000) + 7,
+                                       pow(big_integer(10), 48080),
+                                       -pow(big_integer(10), 9216 * 3), pow(big_integer(10), 9216 * 2) - 1};
+    std::stringstream ss;
+    for (big_integer const& x : values)
+    {
+        std::ostringstream out;
+        out << x;
+        EXPECT_EQ(to_string(x), out.str());
+        ss << x << ' ';
+    }
+    for (big_integer const& x : values)
+    {
+        big_integer y = 5;
+        ss >> y;
+        EXPECT_EQ(x, y);
+    }
+    big_integer y = 5;
+    EXPECT_FALSE(ss >> y);
+    EXPECT_TRUE(ss.eof());
+    EXPECT_EQ(5, y);
+
+    std::ostringstream padded;
+    padded << std::setw(6) << big_integer(-42) << std::left << std::setw(4) << big_integer(7) << '|';
+    EXPECT_EQ("   -427   |", padded.str());
+
+    std::istringstream in("  +0012 -7x 99 abc");
+    big_integer a, b, c;
+    in >> a >> b;
+    EXPECT_EQ(12, a);
+    EXPECT_EQ(-7, b);
+    EXPECT_EQ('x', in.get());
+    in >> c;
+    EXPECT_EQ(99, c);
+    EXPECT_FALSE(in >> c);
+    EXPECT_EQ(99, c);
+}
+
 namespace
 {
     template <typename T>
@@ -750,3 +912,946 @@ TEST(correctness, converting_ctor4)
     EXPECT_EQ(to_string(bignum), std::to_string(num));
 }
 
+
+TEST(correctness, is_probable_prime_small)
+{
+    for (int i = -10; i < 5000; i++)
+    {
+        bool prime = i >= 2;
+        for (int j = 2; j * j <= i && prime; j++)
+        {
+            prime = (i % j != 0);
+        }
+        EXPECT_EQ(prime, is_probable_prime(i)) << i;
+    }
+}
+
+TEST(correctness, is_probable_prime_big)
+{
+    big_integer mersenne_127 = (big_integer(1) << 127) - 1;
+    big_integer mersenne_521 = (big_integer(1) << 521) - 1;
+
+    EXPECT_TRUE(is_probable_prime(mersenne_127));
+    EXPECT_TRUE(is_probable_prime(mersenne_521));
+    EXPECT_FALSE(is_probable_prime(mersenne_127 * mersenne_127));
+    EXPECT_FALSE(is_probable_prime(mersenne_127 * mersenne_521));
+    EXPECT_FALSE(is_probable_prime(-mersenne_127));
+    // strong pseudoprime to bases 2, 3, 5 and 7
+    EXPECT_FALSE(is_probable_prime(3215031751LL));
+    // Carmichael number without small factors
+    EXPECT_FALSE(is_probable_prime(big_integer("3825123056546413051")));
+}
+
+TEST(correctness, next_prime)
+{
+    EXPECT_EQ(2, next_prime(-100));
+    EXPECT_EQ(2, next_prime(1));
+    EXPECT_EQ(3, next_prime(2));
+    EXPECT_EQ(4099, next_prime(4093));
+    EXPECT_EQ(big_integer("18446744073709551629"), next_prime(big_integer("18446744073709551616")));
+    EXPECT_EQ(big_integer("100000000000000000039"), next_prime(big_integer("100000000000000000000")));
+    EXPECT_EQ((big_integer(1) << 127) - 1, next_prime((big_integer(1) << 127) - 2));
+}
+
+TEST(correctness, mul_karatsuba)
+{
+    big_integer a = (big_integer(1) << 40000) - 12345;
+    big_integer b = (big_integer(1) << 23456) + 777;
+    big_integer c = (big_integer(3) << 33333) - 1;
+
+    EXPECT_EQ(a * b, (big_integer(1) << 63456) + (big_integer(777) << 40000) - (big_integer(12345) << 23456) -
+                         12345 * 777);
+    EXPECT_EQ((a + c) * (a + c), a * a + 2 * a * c + c * c);
+    EXPECT_EQ(-a * c, a * -c);
+    EXPECT_EQ(a * b * c, a * (b * c));
+}
+
+TEST(correctness, product)
+{
+    std::vector<big_integer> factors;
+    big_integer expected = 1;
+    for (int i = 1; i < 1000; i++)
+    {
+        factors.push_back(i % 3 == 0 ? -i : i);
+        expected *= factors.back();
+    }
+    EXPECT_EQ(expected, product(factors));
+    EXPECT_EQ(1, product(std::vector<big_integer>()));
+    EXPECT_EQ(-30, product(std::vector<int>{2, -3, 5}));
+}
+
+TEST(correctness, factorial)
+{
+    unsigned long long expected = 1;
+    for (uint32_t i = 0; i <= 20; i++)
+    {
+        expected *= std::max(i, 1u);
+        EXPECT_EQ(expected, factorial(i));
+    }
+    EXPECT_EQ(big_integer("93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976"
+                          "156518286253697920827223758251185210916864000000000000000000000000"),
+              factorial(100));
+    EXPECT_EQ(factorial(2021), factorial(2020) * 2021);
+}
+
+TEST(correctness, binomial)
+{
+    EXPECT_EQ(1, binomial(0, 0));
+    EXPECT_EQ(0, binomial(3, 4));
+    EXPECT_EQ(10, binomial(5, 2));
+    EXPECT_EQ(big_integer("100891344545564193334812497256"), binomial(100, 50));
+    EXPECT_EQ(factorial(1000) / (factorial(400) * factorial(600)), binomial(1000, 400));
+}
+
+TEST(correctness, divexact)
+{
+    EXPECT_EQ(binomial(1000, 400), divexact(factorial(1000), factorial(400) * factorial(600)));
+    big_integer const a = pow(big_integer(3), 500) << 70, b = (big_integer(1) << 100) + 7;
+    std::vector<big_integer> divisors = {1, -1, 2, 3, 1000000007, big_integer(UINT32_MAX), big_integer(1) << 64,
+                                         -(big_integer(1) << 31), a, b, -a * b, pow(b, 7)};
+    for (big_integer const& d : divisors)
+    {
+        for (big_integer const& q : {big_integer(0), big_integer(1), big_integer(-5), a, -b, pow(a, 3)})
+        {
+            EXPECT_EQ(q, divexact(q * d, d));
+        }
+    }
+    EXPECT_THROW(divexact(1, 0), std::invalid_argument);
+}
+
+TEST(correctness, isqrt)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        big_integer root = isqrt(i);
+        EXPECT_TRUE(root * root <= i && (root + 1) * (root + 1) > i) << i;
+    }
+    big_integer a = (big_integer(1) << 3001) + 12345;
+    big_integer root = isqrt(a * a - 1);
+    EXPECT_EQ(a - 1, root);
+    EXPECT_EQ(a, isqrt(a * a));
+    EXPECT_EQ(a, isqrt(a * a + 2 * a));
+    EXPECT_THROW(isqrt(-1), std::invalid_argument);
+}
+
+TEST(correctness, pow)
+{
+    EXPECT_EQ(1, pow(big_integer(0), 0));
+    EXPECT_EQ(-27, pow(big_integer(-3), 3));
+    EXPECT_EQ(big_integer(1) << 1000, pow(big_integer(2), 1000));
+}
+
+TEST(correctness, binary_splitting)
+{
+    hypergeometric_series geometric{[](uint64_t k) { return big_integer(1); },
+                                    [](uint64_t k) { return big_integer(k == 0 ? 1 : 2); },
+                                    [](uint64_t) { return big_integer(1); }};
+    binary_splitting_result res = binary_split(geometric, 0, 10);
+    EXPECT_EQ(512, res.q);
+    EXPECT_EQ(1023, res.t);
+    EXPECT_EQ(1998, evaluate_series(geometric, 10, 1000));
+}
+
+TEST(correctness, compute_pi_and_e)
+{
+    EXPECT_EQ("31415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679",
+              to_string(compute_pi(100)));
+    EXPECT_EQ("27182818284590452353602874713526624977572470936999595749669676277240766303535475945713821785251664274",
+              to_string(compute_e(100)));
+}
+
+TEST(correctness, mul_parallel)
+{
+    big_integer a = pow(big_integer(3), 20000) - 1;
+    big_integer b = pow(big_integer(7), 9000) + 1;
+    big_integer c = -pow(big_integer(5), 3000);
+    big_integer ab = a * b, aa = a * a, ac = a * c;
+
+    parallel_options old_options = get_parallel_options();
+    parallel_options options;
+    options.threads = 4;
+    options.mul_threshold = 40;
+    options.mul_min_task_size = 40;
+    set_parallel_options(options);
+    EXPECT_EQ(ab, a * b);
+    EXPECT_EQ(aa, a * a);
+    EXPECT_EQ(ac, a * c);
+    set_parallel_options(old_options);
+}
+
+TEST(correctness, conversion_parallel)
+{
+    std::vector<big_integer> values = {0, -1, pow(big_integer(10), 5000), -pow(big_integer(10), 4321) + 1,
+                                       pow(big_integer(7), 11111), -pow(big_integer(3), 10000) * 1000000000};
+    std::vector<std::string> strings;
+    for (big_integer const& value : values)
+    {
+        strings.push_back(to_string(value));
+    }
+
+    parallel_options old_options = get_parallel_options();
+    parallel_options options;
+    options.threads = 4;
+    options.conversion_threshold = 8;
+    set_parallel_options(options);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        EXPECT_EQ(strings[i], to_string(values[i]));
+        EXPECT_EQ(values[i], big_integer(strings[i]));
+    }
+    EXPECT_EQ(big_integer(strings[2]) - 1, big_integer(std::string(5000, '9')));
+    EXPECT_EQ(big_integer(strings[2]), big_integer("+000" + strings[2]));
+    set_parallel_options(old_options);
+}
+
+namespace
+{
+    struct counting_resource : std::pmr::memory_resource
+    {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t bytes_in_use = 0;
+        size_t peak_bytes = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocations++;
+            bytes_in_use += bytes;
+            peak_bytes = std::max(peak_bytes, bytes_in_use);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            deallocations++;
+            bytes_in_use -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace
+
+TEST(correctness, memory_scope)
+{
+    big_integer a = pow(big_integer(3), 1000);
+    big_integer b = -pow(big_integer(7), 900);
+    big_integer expected = a * b - a / 7 + (b % a);
+
+    counting_resource counter;
+    big_integer result;
+    {
+        big_integer_memory_scope scope(&counter);
+        EXPECT_EQ(&counter, big_integer_memory_resource());
+        big_integer tmp = a * b - a / 7 + (b % a);
+        result = tmp;
+    }
+    EXPECT_NE(&counter, big_integer_memory_resource());
+    EXPECT_GT(counter.allocations, 0u);
+    EXPECT_EQ(counter.allocations, counter.deallocations);
+    EXPECT_EQ(expected, result);
+}
+
+TEST(correctness, stream_read_memory)
+{
+    // 253530 digits, 27 blocks of digits are read and merged
+    big_integer const big = pow(big_integer(7), 300000);
+    std::istringstream in(to_string(big));
+    counting_resource counter;
+    big_integer result;
+    {
+        big_integer_memory_scope scope(&counter);
+        big_integer read;
+        in >> read;
+        result = read;
+    }
+    EXPECT_EQ(big, result);
+    // the result and its last product are held at once, the pending pieces and their powers stay far below that
+    EXPECT_LT(counter.peak_bytes, big.bit_length() / 8 * 5 / 2);
+    EXPECT_EQ(counter.allocations, counter.deallocations);
+}
+
+TEST(correctness, read_decimal_fd)
+{
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    // longer than the buffer of the pipe, so it is written while being read
+    big_integer const big = -pow(big_integer(3), 200000);
+    std::thread writer([&] {
+        std::string text = "  " + to_string(big) + "\n";
+        for (size_t done = 0; done < text.size();)
+        {
+            done += static_cast<size_t>(write(fds[1], text.data() + done, text.size() - done));
+        }
+        close(fds[1]);
+    });
+    EXPECT_EQ(big, read_decimal(fds[0]));
+    writer.join();
+    close(fds[0]);
+
+    ASSERT_EQ(0, pipe(fds));
+    EXPECT_EQ(3, write(fds[1], "12x", 3));
+    close(fds[1]);
+    EXPECT_THROW(read_decimal(fds[0]), std::invalid_argument);
+    close(fds[0]);
+}
+
+TEST(correctness, memory_scope_monotonic)
+{
+    big_integer result;
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        big_integer_memory_scope scope(&arena);
+        result = factorial(1000) / factorial(998);
+    }
+    EXPECT_EQ(999000, result);
+
+    // decimal conversions of large numbers cache powers of ten, which must not live in the arena
+    big_integer const big = pow(big_integer(7), 40000);
+    std::string text;
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        big_integer_memory_scope scope(&arena);
+        std::ostringstream out;
+        out << big;
+        text = out.str();
+    }
+    std::ostringstream out;
+    out << big;
+    EXPECT_EQ(text, out.str());
+    EXPECT_EQ(to_string(big), text);
+
+    // and so must the powers of ten big_decimal rescales by
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        big_integer_memory_scope scope(&arena);
+        text = to_string(big_decimal("1.5").rescale(40));
+    }
+    EXPECT_EQ("1.5" + std::string(39, '0'), text);
+    EXPECT_EQ(text, to_string(big_decimal("1.5").rescale(40)));
+}
+
+TEST(correctness, copy_on_write)
+{
+    counting_resource counter;
+    big_integer_memory_scope scope(&counter);
+    big_integer a = pow(big_integer(3), 10000);
+    big_integer b = -a;
+
+    [[maybe_unused]] size_t allocations = counter.allocations;
+    std::vector<big_integer> copies(10, a);
+    big_integer c = +a;
+    big_integer d = b;
+    d = c;
+#ifdef BIGINT_COPY_ON_WRITE
+    EXPECT_EQ(allocations, counter.allocations);
+#endif
+
+    copies[3] += 1;
+    copies[4] <<= 1;
+    d = -d;
+    EXPECT_EQ(a + 1, copies[3]);
+    EXPECT_EQ(a * 2, copies[4]);
+    EXPECT_EQ(a, copies[5]);
+    EXPECT_EQ(a, c);
+    EXPECT_EQ(b, d);
+    EXPECT_EQ(pow(big_integer(3), 10000), a);
+}
+
+TEST(correctness, fixed_integer_constexpr)
+{
+    constexpr uint128 max = ~uint128(0);
+    static_assert(max + 1 == 0);
+    static_assert(uint128(0) - 1 == max);
+    static_assert((uint128(1) << 127) > (uint128(1) << 126));
+    static_assert(int128(-1) < 0 && int128(-1) >> 100 == -1);
+    static_assert(uint128(UINT64_MAX) * UINT64_MAX == max - (uint128(UINT64_MAX) << 1));
+    static_assert((uint256(1) << 200) / ((uint256(1) << 100) + 1) == (uint256(1) << 100) - 1);
+    static_assert(int256(-1000) / 7 == -142 && int256(-1000) % 7 == -6);
+    EXPECT_EQ("340282366920938463463374607431768211455", to_string(max));
+    EXPECT_EQ("-1", to_string(int128(-1)));
+}
+
+TEST(correctness, fixed_integer_matches_big_integer)
+{
+    big_integer const modulus = big_integer(1) << 256;
+    auto wrap = [&modulus](big_integer const& a, bool is_signed) {
+        big_integer res = (a % modulus + modulus) % modulus;
+        return is_signed && res >= modulus / 2 ? res - modulus : res;
+    };
+    std::vector<big_integer> values = {0, 1, -1, 7, big_integer(UINT32_MAX), -pow(big_integer(3), 100),
+                                       pow(big_integer(5), 80) + 12345, -(big_integer(1) << 255),
+                                       (big_integer(1) << 255) - 1, pow(big_integer(7), 60), -pow(big_integer(11), 33)};
+    for (big_integer const& a : values)
+    {
+        for (big_integer const& b : values)
+        {
+            int256 x(a), y(b);
+            uint256 ux(a), uy(b);
+            EXPECT_EQ(wrap(a + b, true), big_integer(x + y));
+            EXPECT_EQ(wrap(a - b, true), big_integer(x - y));
+            EXPECT_EQ(wrap(a * b, true), big_integer(x * y));
+            EXPECT_EQ(wrap(a & b, true), big_integer(x & y));
+            EXPECT_EQ(wrap(a | b, true), big_integer(x | y));
+            EXPECT_EQ(wrap(a ^ b, true), big_integer(x ^ y));
+            EXPECT_EQ(wrap(a * b, false), big_integer(ux * uy));
+            EXPECT_EQ(a < b, x < y);
+            EXPECT_EQ(wrap(a, false) < wrap(b, false), ux < uy);
+            if (b != 0)
+            {
+                EXPECT_EQ(wrap(a / b, true), big_integer(x / y));
+                EXPECT_EQ(wrap(a % b, true), big_integer(x % y));
+                EXPECT_EQ(wrap(a, false) / wrap(b, false), big_integer(ux / uy));
+                EXPECT_EQ(wrap(a, false) % wrap(b, false), big_integer(ux % uy));
+            }
+        }
+        for (int shift : {0, 1, 31, 32, 33, 100, 255, 256, 300})
+        {
+            EXPECT_EQ(wrap(a << shift, true), big_integer(int256(a) << shift));
+            EXPECT_EQ(wrap(a, true) >> shift, big_integer(int256(a) >> shift));
+            EXPECT_EQ(wrap(a, false) >> shift, big_integer(uint256(a) >> shift));
+        }
+        EXPECT_EQ(to_string(wrap(a, true)), to_string(int256(to_string(a))));
+    }
+}
+
+TEST(correctness, literals)
+{
+    static_assert(big_integer_literal<'4', '2'>::limbs[0] == 42);
+    static_assert(big_integer_literal<'0', 'x', 'F', 'F', 'F', 'F', 'F', 'F', 'F', 'F', '1'>::size() == 2);
+    EXPECT_EQ(0, 0_bi);
+    EXPECT_EQ(-17, -17_bi);
+    EXPECT_EQ(big_integer(UINT64_MAX), 18446744073709551615_bi);
+    EXPECT_EQ(big_integer("123456789012345678901234567890123456789012345678901234567890"),
+              123456789012345678901234567890123456789012345678901234567890_bi);
+    EXPECT_EQ(big_integer(1) << 100, 0x10000000000000000000000000_bi);
+    EXPECT_EQ(big_integer(1) << 70,
+              0b1'0000000000'0000000000'0000000000'0000000000'0000000000'0000000000'0000000000_bi);
+    EXPECT_EQ(511, 0777_bi);
+    EXPECT_EQ(1000000, 1'000'000_bi);
+}
+
+TEST(correctness, stats)
+{
+    big_integer a = pow(big_integer(3), 2000);
+    big_integer b = pow(big_integer(7), 100);
+    big_integer_stats::reset();
+    big_integer c = a * b;
+    c /= b;
+    EXPECT_EQ(a, c);
+    std::string str = to_string(c);
+
+    big_integer_op_stats mul = big_integer_stats::get(big_integer_op::mul);
+    big_integer_op_stats div = big_integer_stats::get(big_integer_op::div);
+    if (big_integer_stats::enabled())
+    {
+        EXPECT_EQ(1u, mul.calls);
+        EXPECT_EQ(1u, mul.size_histogram[6]); // a has 100 limbs
+        EXPECT_EQ(1u, div.calls);
+        EXPECT_EQ(1u, big_integer_stats::get(big_integer_op::to_string).calls);
+        EXPECT_GT(big_integer_stats::allocations(), 0u);
+        EXPECT_GT(big_integer_stats::allocated_bytes(), 400u);
+    }
+    else
+    {
+        EXPECT_EQ(0u, mul.calls + div.calls + big_integer_stats::allocations());
+    }
+
+    big_integer_stats::reset();
+    ++c;
+    --c;
+    --c;
+    if (big_integer_stats::enabled())
+    {
+        EXPECT_EQ(1u, big_integer_stats::get(big_integer_op::add).calls);
+        EXPECT_EQ(2u, big_integer_stats::get(big_integer_op::sub).calls);
+    }
+    EXPECT_EQ(a - 1, c);
+
+    big_integer_stats::reset();
+    std::istringstream in(str);
+    big_integer d;
+    in >> d;
+    EXPECT_EQ(a, d);
+    EXPECT_EQ(big_integer_stats::enabled() ? 1u : 0u, big_integer_stats::get(big_integer_op::parse).calls);
+
+    // a new thread has no scratch yet, the block the Karatsuba product takes is a heap allocation as well
+    big_integer e = pow(big_integer(3), 40000);
+    size_t bytes = e.bit_length() / 8;
+    big_integer_stats::reset();
+    std::thread([&e] { e *= e; }).join();
+    EXPECT_EQ(pow(big_integer(3), 80000), e);
+    if (big_integer_stats::enabled())
+    {
+        EXPECT_GT(big_integer_stats::allocated_bytes(), 6 * bytes);
+    }
+
+    // limbs from a memory scope are counted too
+    std::pmr::monotonic_buffer_resource arena;
+    {
+        big_integer_memory_scope scope(&arena);
+        big_integer_stats::reset();
+        big_integer f = e;
+        EXPECT_EQ(big_integer_stats::enabled(), big_integer_stats::allocated_bytes() >= 2 * bytes);
+    }
+
+    std::ostringstream out;
+    big_integer_stats::dump(out);
+    EXPECT_FALSE(out.str().empty());
+}
+
+TEST(correctness, scalar_operands)
+{
+    std::vector<big_integer> values = {0, 1, -1, big_integer(UINT32_MAX), -big_integer(UINT32_MAX),
+                                       big_integer(1) << 32, -(big_integer(1) << 32), big_integer(UINT64_MAX),
+                                       -big_integer(UINT64_MAX), pow(big_integer(3), 100), -pow(big_integer(7), 77)};
+    std::vector<int64_t> signed_scalars = {0, 1, -1, 7, -7, INT32_MAX, INT32_MIN, UINT32_MAX, INT64_MAX, INT64_MIN};
+    std::vector<uint64_t> unsigned_scalars = {0, 1, 7, UINT32_MAX, uint64_t(UINT32_MAX) + 1, UINT64_MAX};
+    for (big_integer const& a : values)
+    {
+        for (int64_t b : signed_scalars)
+        {
+            big_integer bb(static_cast<long long>(b));
+            EXPECT_EQ(a + bb, a + b);
+            EXPECT_EQ(a - bb, a - b);
+            EXPECT_EQ(bb - a, b - a);
+            EXPECT_EQ(a * bb, a * b);
+            EXPECT_EQ(a * bb, b * a);
+            if (b != 0)
+            {
+                EXPECT_EQ(a / bb, a / b);
+                EXPECT_EQ(a % bb, a % b);
+            }
+        }
+        for (uint64_t b : unsigned_scalars)
+        {
+            big_integer bb(static_cast<unsigned long long>(b));
+            EXPECT_EQ(a + bb, a + b);
+            EXPECT_EQ(a - bb, a - b);
+            EXPECT_EQ(a * bb, a * b);
+            if (b != 0)
+            {
+                EXPECT_EQ(a / bb, a / b);
+                EXPECT_EQ(a % bb, a % b);
+            }
+        }
+    }
+}
+
+TEST(correctness, scalar_operands_in_place)
+{
+    counting_resource counter;
+    big_integer_memory_scope scope(&counter);
+    big_integer a = pow(big_integer(3), 1000);
+    big_integer expected = pow(big_integer(3), 1000);
+    size_t allocations = counter.allocations;
+    a *= 10;
+    a += 12345;
+    a -= 12345u;
+    a /= 10;
+    a %= 2;
+    EXPECT_EQ(allocations, counter.allocations);
+    EXPECT_EQ(expected % 2, a);
+}
+
+TEST(correctness, limb_divisor)
+{
+    std::vector<uint32_t> divisors = {1, 2, 3, 7, 10, 1000000000, 65537, 1u << 31, (1u << 31) + 1, UINT32_MAX};
+    std::vector<uint32_t> limbs = {0, 1, 12345, 0x80000000, UINT32_MAX, 0xDEADBEEF, 999999999};
+    for (uint32_t d : divisors)
+    {
+        limb_divisor divisor(d);
+        for (uint32_t high : limbs)
+        {
+            for (uint32_t low : limbs)
+            {
+                uint32_t number[2] = {low, high};
+                uint64_t value = (static_cast<uint64_t>(high) << 32) | low;
+                EXPECT_EQ(value % d, divisor.remainder(number, 2));
+                EXPECT_EQ(value % d, divisor.divide(number, 2));
+                EXPECT_EQ(value / d, (static_cast<uint64_t>(number[1]) << 32) | number[0]);
+            }
+        }
+    }
+    big_integer a = pow(big_integer(3), 500) - 1;
+    for (uint32_t d : divisors)
+    {
+        EXPECT_EQ(a, a / d * d + a % d);
+        EXPECT_EQ(-a, -a / d * d + -a % d);
+        EXPECT_EQ(a / d, a / big_integer(d));
+    }
+}
+
+TEST(correctness, accumulator)
+{
+    big_integer_accumulator acc;
+    EXPECT_EQ(0, acc.value());
+    big_integer const p64 = big_integer(1) << 64;
+    std::vector<big_integer> values = {0, 1, -1, big_integer(UINT32_MAX), -(big_integer(1) << 32), p64 - 1, -p64,
+                                       pow(big_integer(3), 300), -pow(big_integer(7), 200) - 1};
+    big_integer expected;
+    for (int round = 0; round < 50; round++)
+    {
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            big_integer x = values[i] * (round + 1);
+            if ((round + i) % 3 == 0)
+            {
+                acc -= x;
+                expected -= x;
+            }
+            else
+            {
+                acc += x;
+                expected += x;
+            }
+        }
+        EXPECT_EQ(expected, acc.value());
+    }
+    // the carries of many maximal limbs all pile up in the partial sums
+    big_integer_accumulator ones;
+    big_integer const all_ones = (big_integer(1) << 320) - 1;
+    for (int i = 0; i < 10000; i++)
+    {
+        ones += all_ones;
+    }
+    EXPECT_EQ(all_ones * 10000, ones.value());
+    ones.clear();
+    ones -= p64;
+    EXPECT_EQ(-p64, ones.value());
+}
+
+TEST(correctness, gcd)
+{
+    EXPECT_EQ(0, gcd(0, 0));
+    EXPECT_EQ(5, gcd(0, -5));
+    EXPECT_EQ(6, gcd(-12, 18));
+    big_integer const a = pow(big_integer(2), 100) * pow(big_integer(3), 50) * 7;
+    big_integer const b = pow(big_integer(2), 70) * pow(big_integer(3), 80) * 11;
+    EXPECT_EQ(pow(big_integer(2), 70) * pow(big_integer(3), 50), gcd(a, -b));
+    EXPECT_EQ(1, gcd(pow(big_integer(3), 200), pow(big_integer(2), 300) + 1));
+}
+
+TEST(correctness, big_rational)
+{
+    big_rational const third(1, 3), half(-1, -2);
+    EXPECT_EQ(big_rational(5, 6), third + half);
+    EXPECT_EQ(big_rational(-1, 6), third - half);
+    EXPECT_EQ(big_rational(1, 6), third * half);
+    EXPECT_EQ(big_rational(2, 3), third / half);
+    EXPECT_EQ("-1/6", to_string(half - 2 * third));
+    EXPECT_EQ("3", to_string(big_rational(6, 2)));
+    EXPECT_EQ(5, big_rational(6, 2).numerator() + big_rational(6, -4).denominator());
+    EXPECT_EQ(-3, big_rational(6, -4).numerator());
+    EXPECT_THROW(big_rational(1, 0), std::invalid_argument);
+    EXPECT_THROW(third / 0, std::invalid_argument);
+
+    EXPECT_TRUE(third < half);
+    EXPECT_TRUE(-half < -third);
+    EXPECT_TRUE(big_rational(-1, 3) < 0);
+    EXPECT_TRUE(big_rational(pow(big_integer(10), 50), 3) > big_rational(1, pow(big_integer(10), 50)));
+    EXPECT_TRUE(big_rational(-pow(big_integer(10), 50), 3) < big_rational(1, pow(big_integer(10), 50)));
+    EXPECT_EQ(big_rational(2, 4), big_rational(-3, -6));
+
+    // the harmonic numbers keep a growing unreduced denominator in between
+    big_rational h;
+    for (int i = 1; i <= 200; i++)
+    {
+        h += big_rational(1, i);
+        h -= big_rational(1, 2 * i);
+        h += big_rational(1, 2 * i);
+    }
+    big_rational expected;
+    for (int i = 1; i <= 200; i++)
+    {
+        expected += big_rational(1, i);
+        expected.reduce();
+    }
+    EXPECT_EQ(expected, h);
+    EXPECT_EQ(expected.denominator(), h.denominator());
+
+    // the first observation reduces in place, the later ones take no gcd
+    big_rational const sum = big_rational(1, 6) + big_rational(1, 3);
+    EXPECT_EQ("1/2", to_string(sum));
+    big_integer_stats::reset();
+    EXPECT_EQ(1, sum.numerator());
+    EXPECT_EQ(2, sum.denominator());
+    EXPECT_EQ("1/2", to_string(sum));
+    EXPECT_EQ(0u, big_integer_stats::get(big_integer_op::mod).calls);
+    EXPECT_EQ("3/4", to_string(sum + big_rational(1, 4)));
+
+    EXPECT_EQ("0.3333", to_decimal(third, 4));
+    EXPECT_EQ("0.50000000000", to_decimal(half, 11));
+    EXPECT_EQ("-2.142857142857142857142", to_decimal(big_rational(-15, 7), 21));
+    EXPECT_EQ("7", to_decimal(big_rational(15, 2), 0));
+    // the sign is only written with a nonzero digit
+    EXPECT_EQ("0", to_decimal(big_rational(-1, 3), 0));
+    EXPECT_EQ("0.00", to_decimal(big_rational(-1, 3000), 2));
+    EXPECT_EQ("-0.0003", to_decimal(big_rational(-1, 3000), 4));
+    EXPECT_EQ("-0.0000000000333", to_decimal(big_rational(-1, 30000000000LL), 13));
+    EXPECT_EQ("-7", to_decimal(big_rational(-15, 2), 0));
+    std::ostringstream out;
+    write_decimal(out, big_rational(1, 7), 30) << "!";
+    EXPECT_EQ("0.142857142857142857142857142857!", out.str());
+}
+
+TEST(correctness, big_decimal)
+{
+    big_decimal const price("19.99"), rate("0.075");
+    EXPECT_EQ(2u, price.scale());
+    EXPECT_EQ("1.49925", to_string(price * rate));
+    EXPECT_EQ("20.065", to_string(price + rate));
+    EXPECT_EQ("-19.915", to_string(rate - price));
+    EXPECT_EQ("-0.05", to_string(big_decimal(-5, 2)));
+    EXPECT_EQ("0.000", to_string(big_decimal("-0.000")));
+    EXPECT_TRUE(big_decimal("1.5") == big_decimal("1.500"));
+    EXPECT_TRUE(big_decimal("-1.5") < big_decimal("-1.49"));
+    EXPECT_THROW(big_decimal("1.2.3"), std::invalid_argument);
+    EXPECT_THROW(big_decimal("-"), std::invalid_argument);
+    EXPECT_THROW(divide(price, 0, 2), std::invalid_argument);
+
+    // every mode on ties and on values next to them, positive and negative
+    std::vector<std::string> inputs = {"2.5", "3.5", "2.51", "2.49", "-2.5", "-3.5", "-2.51", "-2.49", "2.0"};
+    std::vector<std::pair<rounding_mode, std::vector<std::string>>> expected = {
+        {rounding_mode::down, {"2", "3", "2", "2", "-2", "-3", "-2", "-2", "2"}},
+        {rounding_mode::up, {"3", "4", "3", "3", "-3", "-4", "-3", "-3", "2"}},
+        {rounding_mode::floor, {"2", "3", "2", "2", "-3", "-4", "-3", "-3", "2"}},
+        {rounding_mode::ceiling, {"3", "4", "3", "3", "-2", "-3", "-2", "-2", "2"}},
+        {rounding_mode::half_up, {"3", "4", "3", "2", "-3", "-4", "-3", "-2", "2"}},
+        {rounding_mode::half_down, {"2", "3", "3", "2", "-2", "-3", "-3", "-2", "2"}},
+        {rounding_mode::half_even, {"2", "4", "3", "2", "-2", "-4", "-3", "-2", "2"}}};
+    for (auto const& [mode, results] : expected)
+    {
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            EXPECT_EQ(results[i], to_string(big_decimal(inputs[i]).rescale(0, mode)));
+            // the same fractions on a value far beyond 64 bits go through big_integer
+            big_decimal offset(inputs[i][0] == '-' ? -pow(big_integer(10), 40) : pow(big_integer(10), 40));
+            big_decimal wide = big_decimal(inputs[i]) + offset;
+            EXPECT_EQ(big_decimal(results[i]) + offset, wide.rescale(0, mode));
+        }
+    }
+
+    EXPECT_EQ("0.3333", to_string(divide(1, 3, 4)));
+    EXPECT_EQ("0.6667", to_string(divide(2, 3, 4)));
+    EXPECT_EQ("-0.6666", to_string(divide(-2, 3, 4, rounding_mode::down)));
+    EXPECT_EQ("266.53", to_string(divide(price, rate, 2, rounding_mode::half_even)));
+    EXPECT_EQ("1.4993", to_string((price * rate).rescale(4, rounding_mode::half_up)));
+    EXPECT_EQ("1.49925000", to_string((price * rate).rescale(8)));
+
+    // sums that leave 64 bits come back to the fast path once they are small again
+    big_decimal const max(INT64_MAX, 2);
+    big_decimal sum = max + max + max;
+    EXPECT_EQ(big_decimal(big_integer(INT64_MAX) * 3, 2), sum);
+    sum -= max;
+    sum -= max;
+    EXPECT_EQ(max, sum);
+    EXPECT_EQ(big_integer(INT64_MAX), sum.unscaled_value());
+    EXPECT_EQ("-92233720368547758.08", to_string(big_decimal(INT64_MIN, 2)));
+    EXPECT_EQ("92233720368547758.08", to_string(-big_decimal(INT64_MIN, 2)));
+    EXPECT_EQ(big_decimal("123456789012345678901234567890.123"),
+              divide(big_decimal("123456789012345678901234567890123"), 1000, 3));
+}
+
+TEST(correctness, bit_queries)
+{
+    big_integer const p64 = big_integer(1) << 64;
+    std::vector<big_integer> values = {0, 1, -1, 2, -2, big_integer(UINT32_MAX), -(big_integer(1) << 32), p64 - 1,
+                                       -p64, -p64 + 1, pow(big_integer(3), 100), -pow(big_integer(3), 100)};
+    for (big_integer const& x : values)
+    {
+        bool negative = x < 0;
+        big_integer rest = negative ? ~x : x;
+        size_t length = 0, ones = 0;
+        for (; rest != 0; rest >>= 1, length++)
+        {
+            ones += (rest & 1) == 1;
+        }
+        EXPECT_EQ(length, x.bit_length());
+        EXPECT_EQ(ones, x.popcount());
+        size_t zeros = 0;
+        while (x != 0 && ((x >> static_cast<int>(zeros)) & 1) == 0)
+        {
+            zeros++;
+        }
+        EXPECT_EQ(x == 0 ? SIZE_MAX : zeros, x.count_trailing_zeros());
+        for (size_t k = 0; k < 200; k += 7)
+        {
+            EXPECT_EQ(((x >> static_cast<int>(k)) & 1) == 1, x.test_bit(k));
+            big_integer const bit = big_integer(1) << static_cast<int>(k);
+            EXPECT_EQ(x | bit, big_integer(x).set_bit(k));
+            EXPECT_EQ(x & ~bit, big_integer(x).clear_bit(k));
+            for (size_t len : {0, 1, 31, 32, 33, 70})
+            {
+                EXPECT_EQ((x >> static_cast<int>(k)) & ((big_integer(1) << static_cast<int>(len)) - 1),
+                          x.extract_bits(k, len));
+            }
+        }
+    }
+    big_integer a;
+    a.set_bit(100).set_bit(3);
+    EXPECT_EQ((big_integer(1) << 100) + 8, a);
+    a.clear_bit(100);
+    EXPECT_EQ(8, a);
+}
+
+TEST(correctness, rns_integer)
+{
+    rns_basis const basis = rns_basis::for_bits(1000);
+    EXPECT_GT(basis.product().bit_length(), 1001u);
+    for (size_t i = 0; i < basis.size(); i++)
+    {
+        EXPECT_TRUE(is_probable_prime(big_integer(basis.modulus(i)), 20));
+    }
+
+    // a chain of multiply-adds that stays below 2^1000 in magnitude
+    big_integer expected = 1;
+    rns_integer x(basis, 1);
+    rns_integer const factor(basis, big_integer("-123456789012345678901234567890"));
+    rns_integer const addend(basis, -(big_integer(1) << 70) + 12345);
+    for (int i = 0; i < 10; i++)
+    {
+        expected = expected * big_integer("-123456789012345678901234567890") - (big_integer(1) << 70) + 12345;
+        x = x * factor + addend;
+        EXPECT_EQ(expected, x.to_big_integer());
+    }
+    EXPECT_EQ(-expected, (-x).to_big_integer());
+    EXPECT_EQ(0, (x - x).to_big_integer());
+    EXPECT_EQ(expected * 2, (x + x).to_big_integer());
+    EXPECT_EQ(x, rns_integer(basis, expected));
+    EXPECT_NE(x, rns_integer(basis, expected + 1));
+    for (size_t i = 0; i < basis.size(); i++)
+    {
+        EXPECT_EQ(expected % basis.modulus(i) + (expected < 0 ? basis.modulus(i) : 0), x.residue(i));
+    }
+
+    // the range ends of a small basis, the value wraps around past them
+    rns_basis const small({3, 5, 7});
+    EXPECT_EQ(52, rns_integer(small, 52).to_big_integer());
+    EXPECT_EQ(-52, rns_integer(small, -52).to_big_integer());
+    EXPECT_EQ(-52, rns_integer(small, 53).to_big_integer());
+    EXPECT_EQ(0, rns_integer(small, 105).to_big_integer());
+    rns_basis const coprime({9, 25, 7});
+    EXPECT_EQ(-700, (rns_integer(coprime, 28) * rns_integer(coprime, -25)).to_big_integer());
+
+    EXPECT_THROW(rns_basis({}), std::invalid_argument);
+    EXPECT_THROW(rns_basis({3, 4}), std::invalid_argument);
+    EXPECT_THROW(rns_basis({3, 9}), std::invalid_argument);
+    EXPECT_THROW(rns_basis({3, 1u << 31}), std::invalid_argument);
+    EXPECT_THROW(rns_integer(small, 1) + rns_integer(basis, 1), std::invalid_argument);
+}
+
+TEST(correctness, big_integer_view)
+{
+    big_integer const p64 = big_integer(1) << 64;
+    std::vector<big_integer> values = {0, 1, -1, big_integer(UINT32_MAX), -(big_integer(1) << 32), p64 - 1, -p64,
+                                       pow(big_integer(3), 100), -pow(big_integer(3), 100), pow(big_integer(7), 2000)};
+    for (big_integer const& x : values)
+    {
+        EXPECT_EQ(x, big_integer(big_integer_view(x)));
+        EXPECT_EQ(to_string(x), to_string(big_integer_view(x)));
+        for (big_integer const& y : values)
+        {
+            EXPECT_EQ(x < y ? -1 : y < x ? 1 : 0, compare(x, y));
+            big_integer res;
+            add(res, x, y);
+            EXPECT_EQ(x + y, res);
+            subtract(res, x, y);
+            EXPECT_EQ(x - y, res);
+            multiply(res, x, y);
+            EXPECT_EQ(x * y, res);
+        }
+    }
+
+    // the halves of a number are views of its limbs, extension limbs on top don't change the value
+    big_integer const a = pow(big_integer(3), 1000) + 12345;
+    big_integer_view const whole(a);
+    size_t h = whole.size / 2;
+    big_integer_view low = whole.slice(0, h), high = whole.slice(h, whole.size);
+    EXPECT_EQ(a & ((big_integer(1) << static_cast<int>(32 * h)) - 1), big_integer(low));
+    EXPECT_EQ(a >> static_cast<int>(32 * h), big_integer(high));
+    big_integer res;
+    multiply(res, high, low);
+    EXPECT_EQ(big_integer(high) * big_integer(low), res);
+    uint32_t const padded[] = {5, 0, 0, UINT32_MAX, UINT32_MAX};
+    EXPECT_EQ(0, compare(big_integer_view(padded, 3, false), big_integer(5)));
+    EXPECT_EQ(0, compare(big_integer_view(padded + 3, 2, true), big_integer(-1)));
+    EXPECT_EQ(0, compare(big_integer_view(nullptr, 0, true), big_integer(-1)));
+    EXPECT_EQ(-1, compare(whole.slice(whole.size, 3), big_integer(1)));
+    EXPECT_EQ(0, compare(whole.slice(whole.size, 3), big_integer(0)));
+
+    // the destination may be an operand
+    big_integer b = a;
+    add(b, b, b);
+    EXPECT_EQ(a * 2, b);
+    multiply(b, b, big_integer(-3));
+    EXPECT_EQ(a * -6, b);
+    subtract(b, a, b);
+    EXPECT_EQ(a * 7, b);
+}
+
+TEST(correctness, big_polynomial)
+{
+    auto schoolbook = [](big_polynomial const& a, big_polynomial const& b) {
+        if (a.size() == 0 || b.size() == 0)
+        {
+            return big_polynomial();
+        }
+        std::vector<big_integer> res(a.size() + b.size() - 1);
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            for (size_t j = 0; j < b.size(); j++)
+            {
+                res[i + j] += a[i] * b[j];
+            }
+        }
+        return big_polynomial(res);
+    };
+
+    big_integer const big = pow(big_integer(3), 300);
+    big_integer const p32 = big_integer(1) << 32;
+    std::vector<big_polynomial> polys = {
+        {},
+        {{0, 0}},
+        {{-1}},
+        {{1, 1, 1, 1, 1, 1, 1}},
+        {{-1, -1, -1, -1, -1}},
+        {{p32, -p32, p32 - 1, -(p32 - 1), 0, 1 - p32}},
+        {{big, 0, -big, 1, -1, big * big, -7}},
+        {{0, 0, 0, 0, 0, 0, 0, 0, 5}},
+        {{-big, -(big * big), -1, -p32, -big, 3}},
+    };
+    std::vector<big_integer> many;
+    for (int i = 0; i < 60; i++)
+    {
+        many.push_back(i % 3 == 0 ? -pow(big_integer(7), i) : i % 3 == 1 ? big_integer(i) : pow(big_integer(5), 3 * i));
+    }
+    polys.emplace_back(many);
+
+    EXPECT_EQ(0u, polys[1].size());
+    EXPECT_EQ(polys[0], polys[1]);
+    for (big_polynomial const& a : polys)
+    {
+        EXPECT_EQ(a, a + big_polynomial() - big_polynomial());
+        EXPECT_EQ(big_polynomial(), a - a);
+        for (big_polynomial const& b : polys)
+        {
+            big_polynomial product = a * b;
+            EXPECT_EQ(schoolbook(a, b), product);
+            EXPECT_EQ(a(big_integer(-3)) * b(big_integer(-3)), product(big_integer(-3)));
+            EXPECT_EQ(a(big) + b(big), (a + b)(big));
+            EXPECT_EQ(a(big) - b(big), (a - b)(big));
+        }
+    }
+
+    // squaring in place
+    big_polynomial c = polys.back();
+    c *= c;
+    EXPECT_EQ(schoolbook(polys.back(), polys.back()), c);
+    EXPECT_EQ(119u, c.size());
+    EXPECT_EQ(many.back() * many.back(), c[118]);
+}
@@ -0,0 +1,152 @@
+#include "thread_pool.h"
+
+namespace
+{
+    thread_local thread_pool const* current_pool = nullptr;
+    thread_local size_t current_index = 0;
+} // namespace
+
+thread_pool::thread_pool(size_t threads)
+{
+    for (size_t i = 0; i <= threads; i++)
+    {
+        queues.push_back(std::make_unique<queue>());
+    }
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+size_t thread_pool::size() const
+{
+    return workers.size();
+}
+
+size_t thread_pool::own_queue() const
+{
+    return current_pool == this ? current_index : workers.size();
+}
+
+void thread_pool::push(task t)
+{
+    queue& q = *queues[own_queue()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(t);
+    }
+    queued++;
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    wake.notify_one();
+}
+
+bool thread_pool::try_pop(task& t)
+{
+    size_t own = own_queue();
+    {
+        queue& q = *queues[own];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty())
+        {
+            t = q.tasks.back();
+            q.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++)
+    {
+        queue& q = *queues[(own + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty())
+        {
+            t = q.tasks.front();
+            q.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void thread_pool::execute(task const& t)
+{
+    try
+    {
+        (*t.function)();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(t.owner->error_mutex);
+        if (!t.owner->error)
+        {
+            t.owner->error = std::current_exception();
+        }
+    }
+    t.owner->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void thread_pool::run(std::vector<std::function<void()>> const& tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+    group g;
+    g.pending = tasks.size();
+    for (size_t i = 1; i < tasks.size(); i++)
+    {
+        push({&tasks[i], &g});
+    }
+    execute({&tasks[0], &g});
+    while (g.pending.load(std::memory_order_acquire) != 0)
+    {
+        task t{};
+        if (try_pop(t))
+        {
+            execute(t);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    if (g.error)
+    {
+        std::rethrow_exception(g.error);
+    }
+}
+
+void thread_pool::worker_loop(size_t index)
+{
+    current_pool = this;
+    current_index = index;
+    while (true)
+    {
+        task t{};
+        if (try_pop(t))
+        {
+            execute(t);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stop || queued.load() > 0; });
+        if (stop && queued.load() == 0)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool for fork-join style tasks. Every worker owns a deque: it takes its own newest task
+// from the back and steals the oldest tasks of the others from the front. A thread waiting in run()
+// executes pending tasks itself, so tasks may call run() recursively without deadlocking.
+class thread_pool
+{
+public:
+    explicit thread_pool(size_t threads);
+    ~thread_pool();
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+
+    size_t size() const;
+
+    // executes all the tasks and returns when every one of them finished,
+    // the first exception thrown by a task is rethrown here
+    void run(std::vector<std::function<void()>> const& tasks);
+
+private:
+    struct group
+    {
+        std::atomic<size_t> pending;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    struct task
+    {
+        std::function<void()> const* function;
+        group* owner;
+    };
+
+    struct queue
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    size_t own_queue() const;
+    void push(task t);
+    bool try_pop(task& t);
+    void execute(task const& t);
+    void worker_loop(size_t index);
+
+    // one queue per worker and the last one for the threads outside of the pool
+    std::vector<std::unique_ptr<queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop = false;
+};